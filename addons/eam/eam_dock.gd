@@ -4,9 +4,20 @@ extends Control
 
 @onready var reload_button: Button = $VSplitContainer/HBoxContainer/ReloadBtn
 @onready var manage_button: Button = $VSplitContainer/HBoxContainer/ManageBtn
+@onready var log_level_button: OptionButton = $VSplitContainer/HBoxContainer/LogLevelBtn
 @onready var asset_tab_container := $VSplitContainer/AssetTabContainer
 
 var config_window : Window
+var log_view : RichTextLabel
+var log_entry_count := -1
+
+const LOG_TAB_NAME := "Log"
+const LOG_LEVEL_COLORS := {
+	AssetLogger.LEVEL_TRACE: "gray",
+	AssetLogger.LEVEL_DEBUG: "gray",
+	AssetLogger.LEVEL_WARNING: "yellow",
+	AssetLogger.LEVEL_ERROR: "red",
+}
 
 var asset_types := Identifier.get_all_resource_types()
 
@@ -14,6 +25,7 @@ var asset_types := Identifier.get_all_resource_types()
 func _ready() -> void:
 	reload_button.pressed.connect(_rebuild_asset_list)
 	manage_button.pressed.connect(_open_config_window)
+	_setup_log_level_button()
 	_build_asset_list()
 
 
@@ -93,6 +105,49 @@ func _build_asset_list():
 		tab_scroll.add_child(category_continers[category_name])
 		asset_tab_container.add_child(tab_scroll)
 
+	_build_log_tab()
+
+
+func _setup_log_level_button():
+	for level in range(AssetLogger.LEVEL_NONE + 1):
+		log_level_button.add_item(AssetLogger.get_level_name(level), level)
+		# levels below the compiled minimum can not be turned on at runtime
+		log_level_button.set_item_disabled(level, level < AssetLogger.get_compiled_min_level())
+	log_level_button.select(AssetLogger.get_level())
+	log_level_button.item_selected.connect(
+		func level_selected(index):
+			AssetLogger.set_level(log_level_button.get_item_id(index))
+	)
+
+
+func _build_log_tab():
+	log_view = RichTextLabel.new()
+	log_view.name = LOG_TAB_NAME
+	log_view.bbcode_enabled = true
+	log_view.scroll_following = true
+	log_view.selection_enabled = true
+	log_view.size_flags_horizontal = Control.SIZE_EXPAND_FILL
+	log_view.size_flags_vertical = Control.SIZE_EXPAND_FILL
+	asset_tab_container.add_child(log_view)
+
+	log_entry_count = -1
+	_refresh_log()
+
+
+func _refresh_log():
+	var total_entries := AssetLogger.get_total_entries()
+	if log_view == null or total_entries == log_entry_count:
+		return
+	log_entry_count = total_entries
+
+	log_view.clear()
+	for entry in AssetLogger.get_recent_entries():
+		var message: String = entry.message.replace("[", "[lb]")
+		var line := "[lb]%s] %s: %s" % [entry.level_name, entry.source, message]
+		if entry.level in LOG_LEVEL_COLORS:
+			line = "[color=%s]%s[/color]" % [LOG_LEVEL_COLORS[entry.level], line]
+		log_view.append_text(line + "\n")
+
 
 func _copy_asset_id(input_event: InputEvent, clipboard_text: String):
 	if input_event is InputEventMouseButton:
@@ -111,4 +166,5 @@ func _open_config_window():
 	
 # Called every frame. 'delta' is the elapsed time since the previous frame.
 func _process(delta: float) -> void:
-	pass
+	if is_visible_in_tree():
+		_refresh_log()
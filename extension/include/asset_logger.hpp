@@ -0,0 +1,104 @@
+#pragma once
+
+#include "base_include.hpp"
+#include "godot_cpp/classes/mutex.hpp"
+#include "godot_cpp/core/mutex_lock.hpp"
+#include "godot_cpp/templates/local_vector.hpp"
+
+#include <atomic>
+
+// Lowest level compiled into the extension; calls below it are removed entirely.
+// 0 = trace, 1 = debug, 2 = info, 3 = warning, 4 = error, 5 = none.
+#ifndef EAM_LOG_MIN_LEVEL
+#ifdef DEBUG_ENABLED
+#define EAM_LOG_MIN_LEVEL 1
+#else
+#define EAM_LOG_MIN_LEVEL 2
+#endif
+#endif
+
+// The message arguments are only evaluated and formatted when the level is enabled.
+#define EAM_LOG(m_level, ...)                                                                        \
+	do {                                                                                             \
+		if constexpr (static_cast<int>(m_level) >= EAM_LOG_MIN_LEVEL) {                              \
+			if (godot::AssetLogger::is_enabled(m_level)) {                                           \
+				godot::AssetLogger::write(m_level, __FILE__, __LINE__, godot::UtilityFunctions::str(__VA_ARGS__)); \
+			}                                                                                        \
+		}                                                                                            \
+	} while (0)
+
+#define EAM_LOG_TRACE(...) EAM_LOG(godot::AssetLogger::LEVEL_TRACE, __VA_ARGS__)
+#define EAM_LOG_DEBUG(...) EAM_LOG(godot::AssetLogger::LEVEL_DEBUG, __VA_ARGS__)
+#define EAM_LOG_INFO(...) EAM_LOG(godot::AssetLogger::LEVEL_INFO, __VA_ARGS__)
+#define EAM_LOG_WARNING(...) EAM_LOG(godot::AssetLogger::LEVEL_WARNING, __VA_ARGS__)
+#define EAM_LOG_ERROR(...) EAM_LOG(godot::AssetLogger::LEVEL_ERROR, __VA_ARGS__)
+
+namespace godot {
+
+// Leveled log for the extension with a ring buffer of recent entries.
+// Warnings and errors go to the engine's error output, everything else to the console.
+class GDE_EXPORT AssetLogger : public Object {
+	GDCLASS(AssetLogger, Object)
+
+public:
+	enum Level {
+		LEVEL_TRACE,
+		LEVEL_DEBUG,
+		LEVEL_INFO,
+		LEVEL_WARNING,
+		LEVEL_ERROR,
+		LEVEL_NONE,
+	};
+
+	static constexpr int32_t MAX_RECENT_ENTRIES = 1024;
+
+private:
+	struct Entry {
+		uint64_t time_msec = 0;
+		Level level = LEVEL_INFO;
+		String source;
+		int32_t line = 0;
+		String message;
+	};
+
+	static std::atomic<int32_t> runtime_level;
+	static std::atomic<bool> console_enabled;
+
+	// Null outside the module's lifetime; entries written then skip the ring buffer.
+	static Ref<godot::Mutex> entries_mutex;
+	static LocalVector<Entry> entries;
+	static uint32_t next_entry;
+	static uint64_t total_entries;
+
+protected:
+	static void _bind_methods();
+
+public:
+	AssetLogger();
+	~AssetLogger();
+
+	static inline bool is_enabled(Level level) {
+		return level >= runtime_level.load(std::memory_order_relaxed);
+	}
+
+	static void write(Level level, const char *file, int32_t line, const String &message);
+
+	static void set_level(Level level);
+	static Level get_level();
+	static Level get_compiled_min_level();
+
+	static void set_console_enabled(bool enabled);
+	static bool is_console_enabled();
+
+	static String get_level_name(Level level);
+	static TypedArray<Dictionary> get_recent_entries(int32_t max_count = MAX_RECENT_ENTRIES);
+	static uint64_t get_total_entries();
+	static void clear_recent_entries();
+
+	static void initialize_recent_entries();
+	static void release_recent_entries();
+};
+
+} //namespace godot
+
+VARIANT_ENUM_CAST(AssetLogger::Level);
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "dynamic_content_loader.hpp"
+#include "godot_cpp/classes/audio_stream.hpp"
+#include "godot_cpp/classes/mutex.hpp"
+#include "godot_cpp/core/mutex_lock.hpp"
+#include "godot_cpp/templates/list.hpp"
+
+namespace godot {
+
+// Loads OGG Vorbis, WAV and MP3 files into AudioStreams.
+// Small sound effects are pooled and shared; long tracks stay compressed in memory
+// and are decoded while they play.
+class GDE_EXPORT AudioContentLoader : public DynamicContentLoader {
+	GDCLASS(AudioContentLoader, DynamicContentLoader)
+
+private:
+	struct PooledStream {
+		Ref<AudioStream> stream;
+		uint64_t modified_time = 0;
+		int64_t size = 0;
+	};
+
+	// Files at least this large are treated as music rather than sound effects.
+	int64_t music_min_file_size = 1024 * 1024;
+	int64_t sfx_pool_budget = 16 * 1024 * 1024;
+
+	mutable HashMap<String, PooledStream> sfx_pool;
+	mutable List<String> sfx_pool_order;
+	mutable int64_t sfx_pool_bytes = 0;
+	Ref<godot::Mutex> pool_mutex = nullptr;
+
+	Ref<AudioStream> get_pooled_stream(const String &p_path, uint64_t modified_time) const;
+	void pool_stream(const String &p_path, uint64_t modified_time, int64_t size, const Ref<AudioStream> &stream) const;
+	Ref<AudioStream> decode_stream(const String &p_path, bool is_music) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	AudioContentLoader();
+	~AudioContentLoader();
+
+	virtual String get_loader_name() const override;
+	virtual String get_resource_type() const override;
+	virtual PackedStringArray get_recognized_extensions() const override;
+
+	virtual bool is_thread_safe() const override;
+	virtual LoadThread get_preferred_thread() const override;
+	virtual CachePolicy get_cache_policy() const override;
+
+	virtual Variant decode_from_path(const String &p_path) const override;
+
+	void set_music_min_file_size(int64_t p_size);
+	int64_t get_music_min_file_size() const;
+	void set_sfx_pool_budget(int64_t p_budget);
+	int64_t get_sfx_pool_budget() const;
+
+	void clear_sfx_pool();
+};
+
+} //namespace godot
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "base_include.hpp"
+#include "godot_cpp/classes/mutex.hpp"
+#include "godot_cpp/core/mutex_lock.hpp"
+
+#include "dynamic_content_loader.hpp"
+
+namespace godot {
+
+// Maps content types to the native loaders that handle them.
+// New formats are added by registering a loader, not by editing the prefix handler.
+class GDE_EXPORT ContentLoaderRegistry : public RefCounted {
+	GDCLASS(ContentLoaderRegistry, RefCounted)
+
+private:
+	HashMap<String, Vector<Ref<DynamicContentLoader>>> loader_map;
+	Vector<Ref<DynamicContentLoader>> fallback_loaders;
+
+	Ref<godot::Mutex> registry_mutex = nullptr;
+
+	static Ref<ContentLoaderRegistry> _ContentLoaderRegistrySingleton;
+
+protected:
+	static void _bind_methods();
+
+public:
+	static Ref<ContentLoaderRegistry> get_singleton() { 
+		if (_ContentLoaderRegistrySingleton.is_null()) {
+			_ContentLoaderRegistrySingleton.instantiate();
+		}
+
+		return _ContentLoaderRegistrySingleton;
+	}
+
+	static void destory_singleton() {
+		if (_ContentLoaderRegistrySingleton.is_valid()) {
+			_ContentLoaderRegistrySingleton.unref();
+		}
+	}
+
+	ContentLoaderRegistry();
+	~ContentLoaderRegistry();
+
+	void register_default_loaders();
+
+	void register_loader(String content_type, Ref<DynamicContentLoader> loader);
+	void register_fallback_loader(Ref<DynamicContentLoader> loader);
+	void unregister_loader(Ref<DynamicContentLoader> loader);
+
+	Ref<DynamicContentLoader> get_loader(String content_type, String file_path) const;
+	Ref<DynamicContentLoader> get_loader_by_name(String loader_name) const;
+	TypedArray<DynamicContentLoader> get_all_loaders() const;
+	TypedArray<String> get_registered_content_types() const;
+
+	void wait_for_background_tasks() const;
+};
+
+} //namespace godot
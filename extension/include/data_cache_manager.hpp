@@ -2,18 +2,155 @@
 
 #include "base_include.hpp"
 #include "identifier.hpp"
+#include "data_cache_store.hpp"
+#include "godot_cpp/classes/file_access.hpp"
+#include "godot_cpp/classes/mutex.hpp"
+#include "godot_cpp/core/mutex_lock.hpp"
+#include "godot_cpp/templates/hash_set.hpp"
+#include "godot_cpp/templates/list.hpp"
+#include "godot_cpp/templates/local_vector.hpp"
 
 namespace godot {
 
-// Caches JSON files by SHA256 hash in user:// directory.
+// Caches JSON files by content hash in user:// directory.
 // Supports file and string caching with validation.
+// A manifest of entry sizes and modification times lets startup trust entries without re-hashing them.
+// Keys are SHA256 hex digests by default, or 16 hex digit XXH64 digests when hash_algorithm is XXH64.
 class GDE_EXPORT DataCacheManager : public RefCounted {
 	GDCLASS(DataCacheManager, RefCounted)
 
+public:
+	enum HashAlgorithm {
+		HASH_ALGORITHM_SHA256,
+		HASH_ALGORITHM_XXH64,
+	};
+
+	enum CacheCompression {
+		CACHE_COMPRESSION_NONE,
+		CACHE_COMPRESSION_ZSTD,
+		CACHE_COMPRESSION_DEFLATE,
+	};
+
+	enum StorageBackend {
+		STORAGE_BACKEND_FILES,
+		STORAGE_BACKEND_STORE,
+	};
+
+	static constexpr uint32_t MANIFEST_MAGIC = 0x4D4D4145; // "EAMM"
+	static constexpr uint32_t MANIFEST_VERSION = 3;
+
 private:
+	struct ManifestEntry {
+		uint64_t size = 0;
+		uint64_t modified_time = 0;
+		HashAlgorithm algorithm = HASH_ALGORITHM_SHA256;
+		CacheCompression compression = CACHE_COMPRESSION_NONE;
+	};
+
+	// Algorithm used for newly cached entries; existing entries keep the one they were stored with.
+	HashAlgorithm hash_algorithm = HASH_ALGORITHM_SHA256;
+	// Compression for newly written entries; stored entries keep theirs, recorded in the file suffix.
+	CacheCompression cache_compression = CACHE_COMPRESSION_ZSTD;
+
+	// Where new entries go; entries already stored in the other backend stay readable.
+	StorageBackend storage_backend = STORAGE_BACKEND_FILES;
+	Ref<DataCacheStore> store = nullptr;
+
     HashMap<String, String> hashed_data_map;
 	bool files_indexed = false;
 
+	// Metadata of entries whose hash has been verified; keyed by hash.
+	HashMap<String, ManifestEntry> manifest_entries;
+	// Files on disk without matching manifest metadata; verified on first use or by the scrubber.
+	HashMap<String, String> unverified_entries;
+	bool manifest_dirty = false;
+	bool manifest_save_queued = false;
+
+	int64_t scrub_task_id = -1;
+	uint32_t scrub_cursor = 0;
+	// Entries discarded or dropped while a background scrub runs; its verdicts on them are stale.
+	HashSet<String> scrub_stale_hashes;
+
+	// Parsed results of get_cached_json, shared read-only between callers.
+	struct ParsedJsonEntry {
+		Variant data;
+		int64_t size = 0;
+		List<String>::Element *lru_element = nullptr;
+	};
+
+	// Cache strings waiting for the background writer; readers are served from memory until the file exists.
+	struct PendingWrite {
+		String hash;
+		String path;
+		String content;
+		CacheCompression compression = CACHE_COMPRESSION_NONE;
+	};
+
+	struct CompletedWrite {
+		String hash;
+		String path;
+		Error error = OK;
+	};
+
+	bool write_behind_enabled = true;
+	Ref<godot::Mutex> write_mutex = nullptr;
+	HashMap<String, String> pending_contents;
+	LocalVector<PendingWrite> write_queue;
+	LocalVector<CompletedWrite> completed_writes;
+	bool writer_running = false;
+	bool completion_queued = false;
+	int64_t writer_task_id = -1;
+
+	HashMap<String, ParsedJsonEntry> parsed_json;
+	List<String> parsed_json_lru;
+	int64_t parsed_json_budget = 16 * 1024 * 1024;
+	int64_t parsed_json_bytes = 0;
+	uint64_t parsed_json_hits = 0;
+	uint64_t parsed_json_misses = 0;
+	uint64_t parsed_json_evictions = 0;
+
+	static ManifestEntry read_entry_metadata(const String &file_path);
+	static HashAlgorithm get_key_algorithm(const String &hash);
+	static bool verify_file_hash(const String &file_path, const String &hash);
+
+	static String get_entry_suffix(CacheCompression compression);
+	static CacheCompression get_path_compression(const String &file_path);
+	static String get_path_key(const String &file_name);
+	static Ref<FileAccess> open_entry(const String &file_path, FileAccess::ModeFlags mode);
+	static String hash_stream(const Ref<FileAccess> &file, HashAlgorithm algorithm);
+	static String read_entry_string(const String &file_path);
+	static Error copy_entry_file(const String &source_path, const String &file_path);
+	static int32_t get_store_compression(CacheCompression compression);
+	static int32_t remove_stale_temp_files(const String &dir_path);
+
+	bool ensure_store();
+	bool is_store_path(const String &file_path) const;
+	String get_new_entry_path(const String &hash) const;
+	String read_entry_content(const String &hash, const String &file_path);
+	bool verify_entry_content(const String &file_path, const String &hash);
+	Error write_entry(const String &hash, const String &file_path, const String &content, CacheCompression compression);
+
+	void load_manifest();
+	void record_entry(const String &hash, const String &file_path);
+	void discard_entry(const String &hash);
+	void forget_parsed_json(const String &hash);
+	void evict_parsed_json();
+	static void make_read_only(const Variant &value);
+
+	static Error write_entry_file(const String &file_path, const String &content);
+	void queue_write(const String &hash, const String &file_path, const String &content, CacheCompression compression);
+	void process_write_queue();
+	void apply_completed_writes();
+	void _apply_completed_writes();
+	bool is_write_pending(const String &hash);
+	void queue_manifest_save();
+	bool verify_entry(const String &hash);
+
+	void collect_scrub_entries(int64_t max_entries, PackedStringArray &r_hashes, PackedStringArray &r_paths);
+	int64_t apply_scrub_results(const PackedStringArray &verified, const PackedStringArray &corrupt, const HashSet<String> &stale_hashes);
+	void scrub_entries(PackedStringArray hashes, PackedStringArray paths);
+	void _finish_background_scrub(PackedStringArray verified, PackedStringArray corrupt);
+
 	static Ref<DataCacheManager> _DataCacheManagerSingleton;
 
 protected:
@@ -40,18 +177,53 @@ public:
 	void index_files();
 	void re_index_files();
 
+	void set_hash_algorithm(HashAlgorithm algorithm);
+	HashAlgorithm get_hash_algorithm() const;
+
+	void set_cache_compression(CacheCompression compression);
+	CacheCompression get_cache_compression() const;
+
+	void set_storage_backend(StorageBackend backend);
+	StorageBackend get_storage_backend() const;
+	Dictionary get_store_stats();
+	Error compact_store();
+
+	void save_manifest();
+	int64_t scrub_cache(int64_t max_entries = -1);
+	bool start_background_scrub();
+	bool is_scrubbing() const;
+	int64_t get_unverified_count() const;
+
 	String cache_file(String file_path);
 	String cache_string(String str);
 
+	void set_write_behind_enabled(bool enabled);
+	bool get_write_behind_enabled() const;
+	int64_t get_pending_write_count();
+	void flush();
+
 	bool is_cached(String hash);
 	String get_cached_string(String hash);
 	Ref<JSON> get_cached_json(String hash);
 
+	void set_parsed_json_budget(int64_t budget_bytes);
+	int64_t get_parsed_json_budget() const;
+	Dictionary get_parsed_json_stats() const;
+	void clear_parsed_json();
+
 	void dump_hash_map();
 	Variant get_hash_map();
 
     static String get_file_hash(String file_path);
 	static String get_string_hash(String str);
+
+	static String compute_file_hash(String file_path, HashAlgorithm algorithm);
+	static String compute_string_hash(String str, HashAlgorithm algorithm);
+	static String hash_buffer(const PackedByteArray &buffer, HashAlgorithm algorithm);
 };
 
 } //namespace godot
+
+VARIANT_ENUM_CAST(DataCacheManager::HashAlgorithm);
+VARIANT_ENUM_CAST(DataCacheManager::CacheCompression);
+VARIANT_ENUM_CAST(DataCacheManager::StorageBackend);
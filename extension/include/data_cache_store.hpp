@@ -0,0 +1,76 @@
+#pragma once
+
+#include "base_include.hpp"
+#include "godot_cpp/classes/file_access.hpp"
+#include "godot_cpp/classes/mutex.hpp"
+#include "godot_cpp/core/mutex_lock.hpp"
+
+namespace godot {
+
+// Append-only log holding data cache entries in a single file, with a hash -> record index beside it.
+// Removed records stay in the log as dead bytes until the log is compacted.
+class GDE_EXPORT DataCacheStore : public RefCounted {
+	GDCLASS(DataCacheStore, RefCounted)
+
+public:
+	static constexpr uint32_t RECORD_MAGIC = 0x52414145; // "EAAR"
+	static constexpr uint32_t INDEX_MAGIC = 0x49414145; // "EAAI"
+	static constexpr uint32_t INDEX_VERSION = 1;
+	// Records stored without compression; otherwise a FileAccess::CompressionMode.
+	static constexpr int32_t COMPRESSION_NONE = -1;
+	// Empty record marking a hash as removed, so a log scanned without its index does not bring it back.
+	static constexpr int32_t COMPRESSION_TOMBSTONE = -2;
+
+private:
+	struct Record {
+		uint64_t data_offset = 0;
+		uint64_t stored_size = 0;
+		uint64_t raw_size = 0;
+		int32_t compression = COMPRESSION_NONE;
+	};
+
+	String log_path = "";
+	String index_path = "";
+
+	Ref<FileAccess> log_file = nullptr;
+	HashMap<String, Record> records;
+	uint64_t log_end = 0;
+	// Bytes of live records in the log, headers included, so only removed records count as dead.
+	uint64_t live_bytes = 0;
+	bool index_dirty = false;
+
+	Ref<godot::Mutex> store_mutex = nullptr;
+
+	static uint64_t get_record_size(const String &hash, const Record &record);
+
+	bool load_index();
+	void scan_log(uint64_t from);
+	Error write_record(const Ref<FileAccess> &file, const String &hash, const Record &record, const PackedByteArray &stored, Record &r_written);
+	Error save_index_locked();
+
+protected:
+	static void _bind_methods();
+
+public:
+	DataCacheStore();
+	~DataCacheStore();
+
+	Error open(const String &directory);
+	void close();
+	bool is_open() const;
+	String get_log_path() const;
+
+	bool has(const String &hash);
+	PackedStringArray get_hashes();
+
+	Error append(const String &hash, const PackedByteArray &data, int32_t compression);
+	PackedByteArray read(const String &hash);
+	void remove(const String &hash);
+
+	Error save_index();
+	bool needs_compaction();
+	Error compact();
+	Dictionary get_stats();
+};
+
+} //namespace godot
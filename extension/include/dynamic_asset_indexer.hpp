@@ -6,6 +6,8 @@
 
 #include "identifier.hpp"
 
+#include <atomic>
+
 namespace godot {
 
 // Indexes asset packs from res:// and user:// directories.
@@ -16,6 +18,11 @@ class GDE_EXPORT DynamicAssetIndexer : public RefCounted {
 private:
     HashMap<String, String> asset_map;
 	bool files_indexed = false;
+	// Bumped under index_mutex, read lock-free by loader threads.
+	std::atomic<uint64_t> index_generation{0};
+
+	// Content fingerprints of indexed files, computed on first request.
+	HashMap<String, String> content_fingerprints;
 	
 	Ref<godot::Mutex> index_mutex = nullptr;
 
@@ -44,8 +51,12 @@ public:
 	
 	void index_files();
 	void re_index_files();
+	uint64_t get_index_generation() const;
 	String get_asset_path(Ref<Identifier> asset_id);
 	TypedArray<String> get_resource_path(String raw_resource_path);
+	String get_content_fingerprint(String file_path);
+
+	static String compute_file_fingerprint(String file_path);
 
 	void dump_asset_map();
 	Variant get_asset_map();
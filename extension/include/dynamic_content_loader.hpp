@@ -0,0 +1,69 @@
+#pragma once
+
+#include "base_include.hpp"
+
+#include <godot_cpp/core/gdvirtual.gen.inc>
+
+namespace godot {
+
+// Base class for native loaders of one dynamic content type.
+// Declares how the prefix handler may schedule and cache its results.
+class GDE_EXPORT DynamicContentLoader : public RefCounted {
+	GDCLASS(DynamicContentLoader, RefCounted)
+
+public:
+	enum LoadThread {
+		LOAD_THREAD_ANY,
+		LOAD_THREAD_WORKER,
+		LOAD_THREAD_CALLER,
+	};
+
+	enum CachePolicy {
+		CACHE_POLICY_NONE,
+		CACHE_POLICY_SHARED,
+		CACHE_POLICY_PERSISTENT,
+	};
+
+protected:
+	static void _bind_methods();
+
+	// Script overrides; each native method dispatches to its hook when a script implements it.
+	GDVIRTUAL0RC(String, _get_loader_name)
+	GDVIRTUAL0RC(String, _get_resource_type)
+	GDVIRTUAL0RC(PackedStringArray, _get_recognized_extensions)
+	GDVIRTUAL0RC(bool, _is_thread_safe)
+	GDVIRTUAL0RC(int, _get_preferred_thread)
+	GDVIRTUAL0RC(int, _get_cache_policy)
+	GDVIRTUAL1RC(Variant, _decode_from_path, String)
+	GDVIRTUAL2RC(Variant, _finalize_resource, Variant, String)
+	GDVIRTUAL1RC(PackedStringArray, _get_dependencies, String)
+	GDVIRTUAL2RC(int64_t, _estimate_resource_size, Variant, String)
+
+public:
+	DynamicContentLoader();
+	~DynamicContentLoader();
+
+	virtual String get_loader_name() const;
+	virtual String get_resource_type() const;
+	virtual PackedStringArray get_recognized_extensions() const;
+
+	virtual bool is_thread_safe() const;
+	virtual LoadThread get_preferred_thread() const;
+	virtual CachePolicy get_cache_policy() const;
+
+	bool recognizes_path(const String &p_path) const;
+
+	virtual Variant decode_from_path(const String &p_path) const;
+	virtual Variant finalize_resource(const Variant &p_decoded, const String &p_path) const;
+	Variant load_from_path(const String &p_path) const;
+
+	virtual PackedStringArray get_dependencies(const String &p_path) const;
+	virtual int64_t estimate_resource_size(const Variant &p_resource, const String &p_path) const;
+
+	virtual void wait_for_background_tasks();
+};
+
+} //namespace godot
+
+VARIANT_ENUM_CAST(DynamicContentLoader::LoadThread);
+VARIANT_ENUM_CAST(DynamicContentLoader::CachePolicy);
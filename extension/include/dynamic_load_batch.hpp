@@ -0,0 +1,52 @@
+#pragma once
+
+#include "base_include.hpp"
+#include "godot_cpp/classes/mutex.hpp"
+#include "godot_cpp/classes/resource.hpp"
+#include "godot_cpp/core/mutex_lock.hpp"
+#include "godot_cpp/templates/local_vector.hpp"
+
+#include <atomic>
+
+namespace godot {
+
+class DynmaicPrefixHandler;
+
+// A set of dynamic resources preloaded concurrently on WorkerThreadPool threads.
+// Keeps the loaded resources alive until the batch is released.
+class GDE_EXPORT DynamicLoadBatch : public RefCounted {
+	GDCLASS(DynamicLoadBatch, RefCounted)
+
+private:
+	DynmaicPrefixHandler *handler = nullptr;
+
+	int64_t batch_id = 0;
+	PackedStringArray resource_paths;
+	LocalVector<Ref<Resource>> loaded_resources;
+
+	std::atomic<uint32_t> processed_count{0};
+	std::atomic<uint32_t> failed_count{0};
+
+	// The pool keeps the group task record until it is waited on once; guarded by wait_mutex.
+	int64_t group_task_id = -1;
+	bool task_waited = false;
+	Ref<godot::Mutex> wait_mutex = nullptr;
+
+protected:
+	static void _bind_methods();
+
+public:
+	DynamicLoadBatch();
+	~DynamicLoadBatch();
+
+	void start(DynmaicPrefixHandler *p_handler, int64_t p_batch_id, const PackedStringArray &p_paths, bool p_high_priority);
+	void load_element(uint32_t p_index);
+	void wait();
+
+	bool is_completed() const;
+	float get_progress() const;
+	int64_t get_failed_count() const;
+	Array get_resources() const;
+};
+
+} //namespace godot
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "base_include.hpp"
+#include "godot_cpp/classes/mutex.hpp"
+#include "godot_cpp/classes/resource.hpp"
+#include "godot_cpp/classes/weak_ref.hpp"
+#include "godot_cpp/core/mutex_lock.hpp"
+
+namespace godot {
+
+// Weak identity cache of natively loaded dynamic resources.
+// Entries are keyed by asset identifier or content fingerprint and tagged with the indexer generation they were resolved in.
+class GDE_EXPORT DynamicResourceCache : public RefCounted {
+	GDCLASS(DynamicResourceCache, RefCounted)
+
+private:
+	struct CacheEntry {
+		Ref<WeakRef> resource_ref;
+		uint64_t generation = 0;
+	};
+
+	HashMap<String, CacheEntry> entries;
+	uint32_t inserts_since_prune = 0;
+
+	Ref<godot::Mutex> cache_mutex = nullptr;
+
+	void _prune_dead_entries();
+
+protected:
+	static void _bind_methods();
+
+public:
+	DynamicResourceCache();
+	~DynamicResourceCache();
+
+	Ref<Resource> get_resource(String resource_key, uint64_t generation);
+	void store_resource(String resource_key, uint64_t generation, Ref<Resource> resource);
+	void remove_resource(String resource_key);
+
+	void clear();
+	int64_t get_entry_count();
+};
+
+} //namespace godot
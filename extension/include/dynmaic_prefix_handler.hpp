@@ -3,17 +3,56 @@
 #include "base_include.hpp"
 
 #include "godot_cpp/classes/resource_format_loader.hpp"
+#include "godot_cpp/classes/mutex.hpp"
+#include "godot_cpp/core/mutex_lock.hpp"
+
+#include "dynamic_content_loader.hpp"
+#include "identifier.hpp"
+#include "dynamic_resource_cache.hpp"
+#include "dynamic_load_batch.hpp"
+#include "resource_residency_manager.hpp"
+#include "load_latency_stats.hpp"
 
 namespace godot {
 
 // Custom resource loader for dynamic:// prefixes.
-// Loads textures, fonts, and JSON from indexed assets.
+// Dispatches indexed assets to the loaders in ContentLoaderRegistry.
 class GDE_EXPORT DynmaicPrefixHandler : public ResourceFormatLoader {
 	GDCLASS(DynmaicPrefixHandler, ResourceFormatLoader)
 private:
-    Variant load_texture_from_path(String fixed_path) const;
-    Variant load_font_from_path(String fixed_path) const;
-    Variant load_json_from_path(String fixed_path) const;
+	// Serializes loaders that are not thread-safe.
+	Ref<godot::Mutex> unsafe_load_mutex = nullptr;
+
+	// Live natively loaded resources, keyed by the dynamic path they were requested with.
+	Ref<DynamicResourceCache> resource_cache = nullptr;
+
+	// Share one resource between identifiers whose files have identical content.
+	bool content_deduplication = false;
+
+	// Keeps recently used resources alive within per content type memory budgets.
+	Ref<ResourceResidencyManager> residency_manager = nullptr;
+
+	// Load time histograms and the debugger monitors showing them.
+	Ref<LoadLatencyStats> latency_stats = nullptr;
+	Vector<StringName> latency_monitor_ids;
+
+	// Preload batches that still hold their resources.
+	HashMap<int64_t, Ref<DynamicLoadBatch>> load_batches;
+	int64_t next_batch_id = 1;
+	Ref<godot::Mutex> batch_mutex = nullptr;
+
+	Ref<DynamicLoadBatch> get_batch(int64_t batch_id);
+
+	bool resolve_dynamic_path(const String &p_path, Ref<Identifier> &r_resource_id, String &r_fixed_path) const;
+
+	Variant load_imported_resource(const String &fixed_path, bool p_use_sub_threads, int32_t p_cache_mode) const;
+	Variant load_resolved_resource(const Ref<Identifier> &resource_id, const String &fixed_path, uint64_t generation, bool p_use_sub_threads, int32_t p_cache_mode) const;
+	Variant run_content_loader(const Ref<DynamicContentLoader> &loader, const String &fixed_path, const String &content_type) const;
+	Variant decode_and_finalize(const Ref<DynamicContentLoader> &loader, const String &fixed_path, const String &content_type) const;
+	Variant load_with_named_loader(const String &loader_name, const String &fixed_path) const;
+
+	void record_latency(const String &content_type, LoadLatencyStats::Stage stage, uint64_t elapsed_usec) const;
+	double get_latency_monitor_value(String content_type, int32_t stage, double percentile);
 
 	static Ref<DynmaicPrefixHandler> _DynmaicPrefixHandlerSingleton;
 protected:
@@ -35,8 +74,43 @@ public:
 	}
 
 	DynmaicPrefixHandler();
+
+	Variant load_dynamic_resource(const String &p_path, bool p_use_sub_threads, int32_t p_cache_mode) const;
+
+	// Kept for scripts written before ContentLoaderRegistry; prefer load() with a dynamic path.
+	Variant load_texture_from_path(String fixed_path) const;
+	Variant load_font_from_path(String fixed_path) const;
+	Variant load_json_from_path(String fixed_path) const;
+
+	int64_t preload_batch(PackedStringArray resource_paths, bool high_priority = false);
+	float get_batch_progress(int64_t batch_id);
+	bool is_batch_completed(int64_t batch_id);
+	Array wait_for_batch(int64_t batch_id);
+	Array get_batch_resources(int64_t batch_id);
+	void release_batch(int64_t batch_id);
+	void release_all_batches();
+	void _finish_batch_task(int64_t batch_id);
+
+	void set_content_deduplication(bool p_enabled);
+	bool get_content_deduplication() const;
+
+	Dictionary get_load_latency_stats();
+	void reset_load_latency_stats();
+	void _register_latency_monitors(String content_type);
+	void release_latency_monitors();
+
+	void set_residency_budget(String content_type, int64_t budget_bytes);
+	int64_t get_residency_budget(String content_type);
+	Dictionary get_residency_stats();
+	void trim_residency();
+	void touch_resource(String resource_path);
+	void release_resident_resources();
+
 	virtual bool _recognize_path(const String &p_path, const StringName &p_type) const override;
 	virtual Variant _load(const String &p_path, const String &p_original_path, bool p_use_sub_threads, int32_t p_cache_mode) const override;
+	virtual PackedStringArray _get_dependencies(const String &p_path, bool p_add_types) const override;
+	virtual String _get_resource_type(const String &p_path) const override;
+	virtual bool _handles_type(const StringName &p_type) const override;
 	virtual Error _rename_dependencies(const String &p_path, const Dictionary &p_renames) const override;
 };
 
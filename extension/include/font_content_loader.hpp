@@ -0,0 +1,71 @@
+#pragma once
+
+#include "dynamic_content_loader.hpp"
+#include "godot_cpp/classes/font_file.hpp"
+#include "godot_cpp/classes/mutex.hpp"
+#include "godot_cpp/classes/weak_ref.hpp"
+#include "godot_cpp/core/mutex_lock.hpp"
+
+namespace godot {
+
+// Loads dynamic fonts from TTF/OTF/WOFF files into FontFiles.
+// Font files are read once and their bytes shared by every FontFile created from them;
+// rasterized glyphs can be persisted in user://cache/fonts between runs.
+class GDE_EXPORT FontContentLoader : public DynamicContentLoader {
+	GDCLASS(FontContentLoader, DynamicContentLoader)
+
+private:
+	struct SharedFontData {
+		PackedByteArray data;
+		uint64_t modified_time = 0;
+		String source_hash;
+		// Fonts created over the bytes; the entry is dropped once all of them are freed.
+		Vector<Ref<WeakRef>> fonts;
+	};
+
+	String glyph_cache_dir = "user://cache/fonts";
+
+	bool glyph_cache_enabled = false;
+	bool msdf_enabled = false;
+
+	// Font bytes by resolved file path, kept while a font created from them is alive.
+	mutable HashMap<String, SharedFontData> shared_font_data;
+	// Fonts whose glyphs should be written out, by glyph cache entry path.
+	mutable HashMap<String, Ref<WeakRef>> glyph_cache_fonts;
+	Ref<godot::Mutex> font_mutex = nullptr;
+
+	SharedFontData get_shared_font_data(const String &p_path) const;
+	void track_shared_font(const String &p_path, const SharedFontData &font_data, const Ref<FontFile> &font) const;
+	void release_unused_font_data() const;
+
+	String get_glyph_cache_path(const String &source_hash) const;
+	Ref<FontFile> load_glyph_cache(const String &entry_path, const PackedByteArray &data) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	FontContentLoader();
+	~FontContentLoader();
+
+	virtual String get_loader_name() const override;
+	virtual String get_resource_type() const override;
+	virtual PackedStringArray get_recognized_extensions() const override;
+
+	virtual bool is_thread_safe() const override;
+	virtual LoadThread get_preferred_thread() const override;
+	virtual CachePolicy get_cache_policy() const override;
+
+	virtual Variant decode_from_path(const String &p_path) const override;
+	virtual int64_t estimate_resource_size(const Variant &p_resource, const String &p_path) const override;
+
+	void set_glyph_cache_enabled(bool p_enabled);
+	bool get_glyph_cache_enabled() const;
+	void set_msdf_enabled(bool p_enabled);
+	bool get_msdf_enabled() const;
+
+	int32_t save_glyph_cache();
+	void clear_font_cache();
+};
+
+} //namespace godot
@@ -27,9 +27,11 @@ public:
 
 	static String get_content_type_from_resouce(String _name);
 	static String get_resource_prefix_from_type(String _name);
+	static void register_content_type(String _prefix, String _content_type);
 
 	static TypedArray<String> get_all_resource_types();
 	static TypedArray<String> get_all_content_types();
+	static void release_content_types();
 
 	String get_content_type() const;
 	String get_content_prefix() const;
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "base_include.hpp"
+#include "godot_cpp/classes/image.hpp"
+#include "godot_cpp/classes/mutex.hpp"
+#include "godot_cpp/classes/semaphore.hpp"
+#include "godot_cpp/core/mutex_lock.hpp"
+
+namespace godot {
+
+// Caps how many image decodes run at once across the threads that request them.
+// File reads happen outside the decode slots, so I/O on one thread overlaps decoding on others.
+class GDE_EXPORT ImageDecodeLimiter : public RefCounted {
+	GDCLASS(ImageDecodeLimiter, RefCounted)
+
+private:
+	int32_t max_concurrency = 0;
+	int32_t active_decodes = 0;
+	int32_t waiting_decodes = 0;
+
+	Ref<godot::Mutex> slot_mutex = nullptr;
+	Ref<godot::Semaphore> slot_semaphore = nullptr;
+
+	static Error decode_buffer(const Ref<Image> &image, const PackedByteArray &buffer, const String &extension);
+
+protected:
+	static void _bind_methods();
+
+public:
+	ImageDecodeLimiter();
+	~ImageDecodeLimiter();
+
+	void set_max_concurrency(int32_t p_max_concurrency);
+	int32_t get_max_concurrency() const;
+
+	void acquire_slot();
+	void release_slot();
+
+	Ref<Image> decode_image(const String &file_path);
+	Ref<Image> decode_image_buffer(const PackedByteArray &buffer, const String &file_path);
+
+	static Vector2i read_image_size(const String &file_path);
+};
+
+} //namespace godot
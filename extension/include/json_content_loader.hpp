@@ -0,0 +1,42 @@
+#pragma once
+
+#include "dynamic_content_loader.hpp"
+
+namespace godot {
+
+// Loads .json files of any content type into JSON resources.
+// Parsed data is kept as binary Variants in user://cache/json, keyed by the source content hash.
+class GDE_EXPORT JsonContentLoader : public DynamicContentLoader {
+	GDCLASS(JsonContentLoader, DynamicContentLoader)
+
+private:
+	String cache_dir = "user://cache/json";
+	bool binary_cache_enabled = true;
+
+	String get_entry_path(const String &source_hash) const;
+	bool load_cached_data(const String &source_hash, Variant &r_data) const;
+	Error store_cached_data(const String &source_hash, const Variant &data) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	JsonContentLoader();
+	~JsonContentLoader();
+
+	virtual String get_loader_name() const override;
+	virtual String get_resource_type() const override;
+	virtual PackedStringArray get_recognized_extensions() const override;
+
+	virtual bool is_thread_safe() const override;
+	virtual LoadThread get_preferred_thread() const override;
+	virtual CachePolicy get_cache_policy() const override;
+
+	virtual Variant decode_from_path(const String &p_path) const override;
+
+	void set_binary_cache_enabled(bool p_enabled);
+	bool get_binary_cache_enabled() const;
+	void clear_json_cache() const;
+};
+
+} //namespace godot
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "base_include.hpp"
+#include "godot_cpp/classes/file_access.hpp"
+#include "godot_cpp/templates/local_vector.hpp"
+
+namespace godot {
+
+// Pull parser reading JSON from a file through a fixed size buffer.
+// Validates and extracts sub-trees without loading the whole document into memory.
+class GDE_EXPORT JsonStreamReader : public RefCounted {
+	GDCLASS(JsonStreamReader, RefCounted)
+
+public:
+	enum Token {
+		TOKEN_NONE,
+		TOKEN_OBJECT_BEGIN,
+		TOKEN_OBJECT_END,
+		TOKEN_ARRAY_BEGIN,
+		TOKEN_ARRAY_END,
+		TOKEN_VALUE,
+		TOKEN_END,
+		TOKEN_ERROR,
+	};
+
+	static constexpr int64_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+	static constexpr int32_t MAX_DEPTH = 512;
+
+private:
+	enum Container : uint8_t {
+		CONTAINER_OBJECT,
+		CONTAINER_ARRAY,
+	};
+
+	Ref<FileAccess> file = nullptr;
+	int64_t buffer_size = DEFAULT_BUFFER_SIZE;
+
+	PackedByteArray buffer;
+	const uint8_t *buffer_ptr = nullptr;
+	int64_t buffer_pos = 0;
+	int64_t buffer_len = 0;
+
+	LocalVector<Container> containers;
+	bool needs_separator = false;
+	bool root_done = false;
+	bool skipping = false;
+
+	// Bytes of the string or number being read; bounded by the largest single token.
+	LocalVector<char> token_bytes;
+
+	Token current_token = TOKEN_NONE;
+	String current_key = "";
+	Variant current_value{};
+
+	Error error = OK;
+	String error_message = "";
+	int32_t line = 1;
+
+	void reset();
+	bool refill();
+	int32_t peek();
+	int32_t next();
+	void skip_whitespace();
+
+	Token set_error(const String &message);
+	Token read_value_token();
+	Token finish_value(Token token);
+
+	bool parse_string(String &r_string);
+	bool parse_number(Variant &r_value);
+	bool parse_literal(const char *literal, const Variant &value, Variant &r_value);
+	void append_codepoint(uint32_t codepoint);
+
+protected:
+	static void _bind_methods();
+
+public:
+	JsonStreamReader();
+	~JsonStreamReader();
+
+	Error open(String file_path, int64_t read_buffer_size = DEFAULT_BUFFER_SIZE);
+	Error open_buffer(PackedByteArray data);
+	void close();
+
+	Token read_next();
+	Token get_token() const;
+	String get_key() const;
+	Variant get_value() const;
+	int32_t get_depth() const;
+
+	Variant read_value();
+	Error skip_value();
+	Error validate();
+	Variant extract(PackedStringArray key_path);
+
+	Error get_error() const;
+	String get_error_message() const;
+	int32_t get_error_line() const;
+
+	static Error validate_file(String file_path);
+	static Variant extract_from_file(String file_path, PackedStringArray key_path);
+};
+
+} //namespace godot
+
+VARIANT_ENUM_CAST(JsonStreamReader::Token);
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "base_include.hpp"
+#include "godot_cpp/classes/mutex.hpp"
+#include "godot_cpp/core/mutex_lock.hpp"
+
+#include <atomic>
+
+namespace godot {
+
+// Lock-free latency histograms for dynamic loads, per content type and load stage.
+// Buckets are powers of two in microseconds; content types get a fixed slot on first use.
+class GDE_EXPORT LoadLatencyStats : public RefCounted {
+	GDCLASS(LoadLatencyStats, RefCounted)
+
+public:
+	enum Stage {
+		STAGE_RESOLVE,
+		STAGE_CACHE,
+		STAGE_IMPORTED,
+		STAGE_DECODE,
+		STAGE_FINALIZE,
+		STAGE_TOTAL,
+		STAGE_MAX,
+	};
+
+	static constexpr int32_t MAX_CONTENT_TYPES = 32;
+	// Bucket i holds samples below 2^(i+1) microseconds; the last one everything above ~16 seconds.
+	static constexpr int32_t BUCKET_COUNT = 25;
+
+private:
+	struct StageHistogram {
+		std::atomic<uint64_t> buckets[BUCKET_COUNT];
+		std::atomic<uint64_t> count;
+		std::atomic<uint64_t> total_usec;
+		std::atomic<uint64_t> max_usec;
+	};
+
+	struct ContentTypeSlot {
+		String content_type;
+		StageHistogram stages[STAGE_MAX];
+	};
+
+	ContentTypeSlot slots[MAX_CONTENT_TYPES];
+	std::atomic<int32_t> slot_count{0};
+	Ref<godot::Mutex> slot_mutex = nullptr;
+
+	int32_t find_slot(const String &content_type) const;
+	int32_t add_slot(const String &content_type);
+	static double get_percentile_ms(const StageHistogram &histogram, double percentile);
+
+protected:
+	static void _bind_methods();
+
+public:
+	LoadLatencyStats();
+	~LoadLatencyStats();
+
+	static String get_stage_name(Stage stage);
+
+	bool record(const String &content_type, Stage stage, uint64_t elapsed_usec);
+	double get_monitor_value(const String &content_type, Stage stage, double percentile) const;
+	Dictionary get_stats() const;
+	void reset();
+};
+
+} //namespace godot
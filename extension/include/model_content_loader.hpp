@@ -0,0 +1,47 @@
+#pragma once
+
+#include "dynamic_content_loader.hpp"
+#include "godot_cpp/classes/packed_scene.hpp"
+
+namespace godot {
+
+// Loads glTF models into PackedScenes on the thread that requests them.
+// Converted scenes are kept as binary .scn files in user://cache/models, keyed by source content hash;
+// a small key file per path, size and modification time stamp skips hashing unchanged sources.
+class GDE_EXPORT ModelContentLoader : public DynamicContentLoader {
+	GDCLASS(ModelContentLoader, DynamicContentLoader)
+
+private:
+	String cache_dir = "user://cache/models";
+	bool scene_cache_enabled = true;
+
+	String get_source_stamp(const String &p_path) const;
+	String get_source_hash(const String &p_path) const;
+	String get_cached_source_hash(const String &p_path) const;
+	String get_entry_path(const String &source_hash) const;
+	Ref<PackedScene> convert_gltf(const String &p_path) const;
+	void store_scene(const String &entry_path, const Ref<PackedScene> &scene) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	ModelContentLoader();
+	~ModelContentLoader();
+
+	virtual String get_loader_name() const override;
+	virtual String get_resource_type() const override;
+	virtual PackedStringArray get_recognized_extensions() const override;
+
+	virtual bool is_thread_safe() const override;
+	virtual LoadThread get_preferred_thread() const override;
+	virtual CachePolicy get_cache_policy() const override;
+
+	virtual Variant decode_from_path(const String &p_path) const override;
+
+	void set_scene_cache_enabled(bool p_enabled);
+	bool get_scene_cache_enabled() const;
+	void clear_scene_cache() const;
+};
+
+} //namespace godot
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "base_include.hpp"
+#include "godot_cpp/classes/mutex.hpp"
+#include "godot_cpp/classes/resource.hpp"
+#include "godot_cpp/core/mutex_lock.hpp"
+#include "godot_cpp/templates/list.hpp"
+
+namespace godot {
+
+// Keeps recently used dynamic resources resident within per content type memory budgets.
+// Least recently used entries that nothing else references are evicted when a budget is exceeded.
+// Repeat load() calls are answered by Godot's ResourceCache without reaching the handler, so use is
+// also inferred from references held elsewhere when evicting, and can be reported with touch_resource.
+class GDE_EXPORT ResourceResidencyManager : public RefCounted {
+	GDCLASS(ResourceResidencyManager, RefCounted)
+
+private:
+	struct ResidentEntry {
+		Ref<Resource> resource;
+		String content_type;
+		int64_t size = 0;
+		List<uint64_t>::Element *lru_element = nullptr;
+	};
+
+	struct ContentTypeState {
+		int64_t budget = 0;
+		int64_t resident_bytes = 0;
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t evictions = 0;
+		List<uint64_t> lru;
+	};
+
+	// Keyed by resource instance id, so every path sharing an instance touches the same entry.
+	HashMap<uint64_t, ResidentEntry> entries;
+	HashMap<String, ContentTypeState> content_types;
+
+	Ref<godot::Mutex> residency_mutex = nullptr;
+
+	void _evict_to_budget(ContentTypeState &state);
+	void _remove_entry(uint64_t resource_id);
+
+protected:
+	static void _bind_methods();
+
+public:
+	ResourceResidencyManager();
+	~ResourceResidencyManager();
+
+	void set_budget(String content_type, int64_t budget_bytes);
+	int64_t get_budget(String content_type);
+	bool has_budget(String content_type);
+
+	void track_resource(String content_type, Ref<Resource> resource, int64_t size_bytes);
+	void touch_resource(Ref<Resource> resource);
+
+	void trim();
+	void clear();
+	Dictionary get_stats();
+};
+
+} //namespace godot
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "base_include.hpp"
+#include "image_decode_limiter.hpp"
+#include "texture_cache.hpp"
+
+#include "godot_cpp/classes/atlas_texture.hpp"
+#include "godot_cpp/classes/image_texture.hpp"
+#include "godot_cpp/classes/mutex.hpp"
+#include "godot_cpp/core/mutex_lock.hpp"
+
+namespace godot {
+
+// Packs the small images of a texture directory into shared atlas pages on first use.
+// Page images and their layout are kept in the texture cache, keyed by the directory contents.
+class GDE_EXPORT TextureAtlasBuilder : public RefCounted {
+	GDCLASS(TextureAtlasBuilder, RefCounted)
+
+private:
+	struct AtlasRegion {
+		int32_t page = 0;
+		Rect2i rect;
+	};
+
+	struct DirectoryAtlas {
+		Vector<Ref<ImageTexture>> pages;
+		HashMap<String, AtlasRegion> regions;
+	};
+
+	String cache_dir = "user://cache/textures";
+
+	int32_t page_size = 2048;
+	int32_t max_image_size = 128;
+
+	Ref<ImageDecodeLimiter> decode_limiter = nullptr;
+	Ref<TextureCache> texture_cache = nullptr;
+	PackedStringArray image_extensions;
+
+	// Built atlases and one build lock per directory, so packing a directory only blocks lookups into it.
+	HashMap<String, DirectoryAtlas> atlases;
+	HashMap<String, Ref<godot::Mutex>> build_mutexes;
+	Ref<godot::Mutex> atlas_mutex = nullptr;
+
+	Ref<AtlasTexture> find_region(const String &file_path, bool &r_built);
+
+	PackedStringArray list_images(const String &dir_path) const;
+	String get_directory_key(const String &dir_path, const PackedStringArray &image_files) const;
+	bool load_cached_atlas(const String &directory_key, DirectoryAtlas &r_atlas) const;
+	void store_cached_atlas(const String &directory_key, const Vector<Ref<Image>> &pages, const HashMap<String, AtlasRegion> &regions) const;
+	DirectoryAtlas build_atlas(const String &dir_path) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	TextureAtlasBuilder();
+	~TextureAtlasBuilder();
+
+	void setup(const Ref<ImageDecodeLimiter> &p_decode_limiter, const Ref<TextureCache> &p_texture_cache, const PackedStringArray &p_image_extensions);
+
+	void set_page_size(int32_t p_page_size);
+	int32_t get_page_size() const;
+	void set_max_image_size(int32_t p_max_image_size);
+	int32_t get_max_image_size() const;
+
+	Ref<AtlasTexture> get_region(const String &file_path);
+	void clear();
+};
+
+} //namespace godot
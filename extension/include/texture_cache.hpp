@@ -0,0 +1,30 @@
+#pragma once
+
+#include "base_include.hpp"
+#include "godot_cpp/classes/image.hpp"
+
+namespace godot {
+
+// Persists processed dynamic texture images in user://cache/textures.
+// Entries are keyed by the source file content hash and the processing variant.
+class GDE_EXPORT TextureCache : public RefCounted {
+	GDCLASS(TextureCache, RefCounted)
+
+private:
+	String cache_dir = "user://cache/textures";
+
+	String get_entry_path(const String &source_hash, const String &variant) const;
+
+protected:
+	static void _bind_methods();
+
+public:
+	TextureCache();
+	~TextureCache();
+
+	Ref<Image> load_image(const String &source_hash, const String &variant) const;
+	Error store_image(const String &source_hash, const String &variant, const Ref<Image> &image) const;
+	void clear() const;
+};
+
+} //namespace godot
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "dynamic_content_loader.hpp"
+#include "image_decode_limiter.hpp"
+#include "texture_cache.hpp"
+#include "texture_atlas_builder.hpp"
+
+#include "godot_cpp/classes/image_texture.hpp"
+#include "godot_cpp/classes/mutex.hpp"
+#include "godot_cpp/core/mutex_lock.hpp"
+#include "godot_cpp/templates/local_vector.hpp"
+
+namespace godot {
+
+// Loads dynamic textures from image files into ImageTextures, or AtlasTexture regions for packed icons.
+// Images are decoded under a concurrency cap on the requesting thread, which also creates the textures.
+class GDE_EXPORT TextureContentLoader : public DynamicContentLoader {
+	GDCLASS(TextureContentLoader, DynamicContentLoader)
+
+public:
+	enum VramCompression {
+		VRAM_COMPRESSION_DISABLED,
+		VRAM_COMPRESSION_AUTO,
+		VRAM_COMPRESSION_BPTC,
+		VRAM_COMPRESSION_S3TC,
+		VRAM_COMPRESSION_ETC2,
+	};
+
+private:
+	Ref<ImageDecodeLimiter> decode_limiter = nullptr;
+	Ref<TextureCache> texture_cache = nullptr;
+	Ref<TextureAtlasBuilder> atlas_builder = nullptr;
+
+	// Directory names whose small images are packed into atlases, e.g. "icons".
+	PackedStringArray atlas_directories;
+
+	VramCompression vram_compression = VRAM_COMPRESSION_DISABLED;
+	bool generate_mipmaps = false;
+
+	bool streaming_enabled = false;
+	int64_t streaming_min_file_size = 1024 * 1024;
+
+	// Background tasks still streaming full resolution images.
+	mutable LocalVector<int64_t> stream_task_ids;
+	Ref<godot::Mutex> stream_mutex = nullptr;
+
+	Image::CompressMode get_compress_mode() const;
+	String get_cache_variant() const;
+	Ref<Image> process_image(const Ref<Image> &image) const;
+
+	Variant decode_full_image(const String &p_path) const;
+	Variant decode_stream_placeholder(const String &p_path) const;
+	String get_preview_key(const String &p_path) const;
+	void store_preview(const String &p_path, const Ref<Image> &image) const;
+
+	void start_stream(const Ref<ImageTexture> &texture, const String &p_path) const;
+	void reap_stream_tasks(bool wait_all) const;
+	void _stream_full_image(Ref<ImageTexture> texture, String p_path);
+
+protected:
+	static void _bind_methods();
+
+public:
+	TextureContentLoader();
+	~TextureContentLoader();
+
+	virtual String get_loader_name() const override;
+	virtual String get_resource_type() const override;
+	virtual PackedStringArray get_recognized_extensions() const override;
+
+	virtual bool is_thread_safe() const override;
+	virtual LoadThread get_preferred_thread() const override;
+	virtual CachePolicy get_cache_policy() const override;
+
+	void set_decode_concurrency(int32_t p_decode_concurrency);
+	int32_t get_decode_concurrency() const;
+
+	void set_vram_compression(VramCompression p_vram_compression);
+	VramCompression get_vram_compression() const;
+
+	void set_generate_mipmaps(bool p_generate_mipmaps);
+	bool get_generate_mipmaps() const;
+
+	void set_streaming_enabled(bool p_streaming_enabled);
+	bool get_streaming_enabled() const;
+
+	void set_streaming_min_file_size(int64_t p_streaming_min_file_size);
+	int64_t get_streaming_min_file_size() const;
+
+	void set_atlas_directories(PackedStringArray p_atlas_directories);
+	PackedStringArray get_atlas_directories() const;
+
+	void set_atlas_page_size(int32_t p_atlas_page_size);
+	int32_t get_atlas_page_size() const;
+
+	void set_atlas_max_image_size(int32_t p_atlas_max_image_size);
+	int32_t get_atlas_max_image_size() const;
+
+	void clear_texture_cache();
+
+	virtual Variant decode_from_path(const String &p_path) const override;
+	virtual Variant finalize_resource(const Variant &p_decoded, const String &p_path) const override;
+	virtual int64_t estimate_resource_size(const Variant &p_resource, const String &p_path) const override;
+
+	virtual void wait_for_background_tasks() override;
+};
+
+} //namespace godot
+
+VARIANT_ENUM_CAST(TextureContentLoader::VramCompression);
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace godot {
+
+// Streaming XXH64: fast non-cryptographic hash used for local content addressing.
+// Plain C++ with no engine dependencies so it can be used from any thread.
+class XXHash64 {
+private:
+	uint64_t accumulators[4];
+	uint64_t seed = 0;
+	uint64_t total_length = 0;
+
+	// Input that did not fill a whole 32 byte stripe yet.
+	uint8_t stripe[32];
+	uint32_t stripe_size = 0;
+
+	void consume_stripe(const uint8_t *data);
+
+public:
+	explicit XXHash64(uint64_t p_seed = 0);
+
+	void reset(uint64_t p_seed = 0);
+	void update(const uint8_t *data, size_t length);
+	uint64_t digest() const;
+
+	static uint64_t hash(const uint8_t *data, size_t length, uint64_t p_seed = 0);
+};
+
+} //namespace godot
@@ -0,0 +1,176 @@
+#include "asset_logger.hpp"
+
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+std::atomic<int32_t> AssetLogger::runtime_level{LEVEL_INFO};
+std::atomic<bool> AssetLogger::console_enabled{true};
+
+Ref<godot::Mutex> AssetLogger::entries_mutex{};
+LocalVector<AssetLogger::Entry> AssetLogger::entries;
+uint32_t AssetLogger::next_entry = 0;
+uint64_t AssetLogger::total_entries = 0;
+
+// Expose AssetLogger methods to Godot.
+void AssetLogger::_bind_methods() {
+	ClassDB::bind_static_method("AssetLogger", D_METHOD("set_level", "level"), &AssetLogger::set_level);
+	ClassDB::bind_static_method("AssetLogger", D_METHOD("get_level"), &AssetLogger::get_level);
+	ClassDB::bind_static_method("AssetLogger", D_METHOD("get_compiled_min_level"), &AssetLogger::get_compiled_min_level);
+
+	ClassDB::bind_static_method("AssetLogger", D_METHOD("set_console_enabled", "enabled"), &AssetLogger::set_console_enabled);
+	ClassDB::bind_static_method("AssetLogger", D_METHOD("is_console_enabled"), &AssetLogger::is_console_enabled);
+
+	ClassDB::bind_static_method("AssetLogger", D_METHOD("get_level_name", "level"), &AssetLogger::get_level_name);
+	ClassDB::bind_static_method("AssetLogger", D_METHOD("get_recent_entries", "max_count"), &AssetLogger::get_recent_entries, DEFVAL(MAX_RECENT_ENTRIES));
+	ClassDB::bind_static_method("AssetLogger", D_METHOD("get_total_entries"), &AssetLogger::get_total_entries);
+	ClassDB::bind_static_method("AssetLogger", D_METHOD("clear_recent_entries"), &AssetLogger::clear_recent_entries);
+
+	BIND_ENUM_CONSTANT(LEVEL_TRACE);
+	BIND_ENUM_CONSTANT(LEVEL_DEBUG);
+	BIND_ENUM_CONSTANT(LEVEL_INFO);
+	BIND_ENUM_CONSTANT(LEVEL_WARNING);
+	BIND_ENUM_CONSTANT(LEVEL_ERROR);
+	BIND_ENUM_CONSTANT(LEVEL_NONE);
+}
+
+AssetLogger::AssetLogger() {}
+
+AssetLogger::~AssetLogger() {}
+
+// Store the entry in the ring buffer and forward it to the engine output.
+void AssetLogger::write(Level level, const char *file, int32_t line, const String &message) {
+	Entry entry;
+	entry.time_msec = Time::get_singleton()->get_ticks_msec();
+	entry.level = level;
+	entry.source = String(file).get_file();
+	entry.line = line;
+	entry.message = message;
+
+	if (entries_mutex.is_valid()){
+		MutexLock lock{**entries_mutex};
+		if (entries.size() < static_cast<uint32_t>(MAX_RECENT_ENTRIES)){
+			entries.push_back(entry);
+		} else {
+			entries[next_entry] = entry;
+		}
+		next_entry = (next_entry + 1) % MAX_RECENT_ENTRIES;
+		total_entries++;
+	}
+
+	if (!console_enabled.load(std::memory_order_relaxed)){
+		return;
+	}
+
+	switch (level){
+		case LEVEL_ERROR:
+			UtilityFunctions::push_error(message);
+			break;
+		case LEVEL_WARNING:
+			UtilityFunctions::push_warning(message);
+			break;
+		default:
+			UtilityFunctions::print(message);
+			break;
+	}
+}
+
+void AssetLogger::set_level(Level level) {
+	runtime_level.store(CLAMP(level, LEVEL_TRACE, LEVEL_NONE), std::memory_order_relaxed);
+}
+
+AssetLogger::Level AssetLogger::get_level() {
+	return static_cast<Level>(runtime_level.load(std::memory_order_relaxed));
+}
+
+// Levels below this were compiled out and cannot be enabled at runtime.
+AssetLogger::Level AssetLogger::get_compiled_min_level() {
+	return static_cast<Level>(EAM_LOG_MIN_LEVEL);
+}
+
+// Keep recording into the ring buffer without printing to the console.
+void AssetLogger::set_console_enabled(bool enabled) {
+	console_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool AssetLogger::is_console_enabled() {
+	return console_enabled.load(std::memory_order_relaxed);
+}
+
+String AssetLogger::get_level_name(Level level) {
+	switch (level){
+		case LEVEL_TRACE:
+			return "trace";
+		case LEVEL_DEBUG:
+			return "debug";
+		case LEVEL_INFO:
+			return "info";
+		case LEVEL_WARNING:
+			return "warning";
+		case LEVEL_ERROR:
+			return "error";
+		default:
+			return "none";
+	}
+}
+
+// Most recent entries, oldest first.
+TypedArray<Dictionary> AssetLogger::get_recent_entries(int32_t max_count) {
+	TypedArray<Dictionary> result;
+	if (entries_mutex.is_null()){
+		return result;
+	}
+
+	MutexLock lock{**entries_mutex};
+	uint32_t count = MIN(static_cast<uint32_t>(MAX(max_count, 0)), entries.size());
+	uint32_t start = (next_entry + entries.size() - count) % MAX(entries.size(), 1u);
+
+	for (uint32_t i = 0; i < count; i++){
+		const Entry &entry = entries[(start + i) % entries.size()];
+
+		Dictionary item;
+		item["time_msec"] = entry.time_msec;
+		item["level"] = entry.level;
+		item["level_name"] = get_level_name(entry.level);
+		item["source"] = entry.source;
+		item["line"] = entry.line;
+		item["message"] = entry.message;
+		result.push_back(item);
+	}
+
+	return result;
+}
+
+// Number of entries written since startup, including ones already overwritten.
+uint64_t AssetLogger::get_total_entries() {
+	if (entries_mutex.is_null()){
+		return total_entries;
+	}
+
+	MutexLock lock{**entries_mutex};
+	return total_entries;
+}
+
+void AssetLogger::clear_recent_entries() {
+	if (entries_mutex.is_null()){
+		return;
+	}
+
+	MutexLock lock{**entries_mutex};
+	entries.reset();
+	next_entry = 0;
+}
+
+// Start recording entries; called when the module is initialized.
+void AssetLogger::initialize_recent_entries() {
+	if (entries_mutex.is_null()){
+		entries_mutex = Ref<godot::Mutex>{memnew(godot::Mutex)};
+	}
+}
+
+// Free the recorded entries and their lock before the engine shuts down.
+void AssetLogger::release_recent_entries() {
+	clear_recent_entries();
+	entries_mutex.unref();
+}
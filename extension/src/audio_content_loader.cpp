@@ -0,0 +1,190 @@
+#include "audio_content_loader.hpp"
+#include "asset_logger.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/audio_stream_mp3.hpp>
+#include <godot_cpp/classes/audio_stream_ogg_vorbis.hpp>
+#include <godot_cpp/classes/audio_stream_wav.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+
+using namespace godot;
+
+// AudioStreamWAV "compress/mode" option value for Quite OK Audio.
+static constexpr int32_t WAV_COMPRESS_QOA = 2;
+
+void AudioContentLoader::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_music_min_file_size", "music_min_file_size"), &AudioContentLoader::set_music_min_file_size);
+	ClassDB::bind_method(D_METHOD("get_music_min_file_size"), &AudioContentLoader::get_music_min_file_size);
+	ClassDB::bind_method(D_METHOD("set_sfx_pool_budget", "sfx_pool_budget"), &AudioContentLoader::set_sfx_pool_budget);
+	ClassDB::bind_method(D_METHOD("get_sfx_pool_budget"), &AudioContentLoader::get_sfx_pool_budget);
+	ClassDB::bind_method(D_METHOD("clear_sfx_pool"), &AudioContentLoader::clear_sfx_pool);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "music_min_file_size", PROPERTY_HINT_NONE, "suffix:B"), "set_music_min_file_size", "get_music_min_file_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "sfx_pool_budget", PROPERTY_HINT_NONE, "suffix:B"), "set_sfx_pool_budget", "get_sfx_pool_budget");
+}
+
+AudioContentLoader::AudioContentLoader():pool_mutex{memnew(godot::Mutex)} {}
+
+AudioContentLoader::~AudioContentLoader() {}
+
+String AudioContentLoader::get_loader_name() const {
+	return "audio";
+}
+
+String AudioContentLoader::get_resource_type() const {
+	return "AudioStream";
+}
+
+PackedStringArray AudioContentLoader::get_recognized_extensions() const {
+	PackedStringArray extensions;
+	extensions.push_back("ogg");
+	extensions.push_back("wav");
+	extensions.push_back("mp3");
+	return extensions;
+}
+
+bool AudioContentLoader::is_thread_safe() const {
+	return true;
+}
+
+DynamicContentLoader::LoadThread AudioContentLoader::get_preferred_thread() const {
+	return LOAD_THREAD_ANY;
+}
+
+DynamicContentLoader::CachePolicy AudioContentLoader::get_cache_policy() const {
+	return CACHE_POLICY_SHARED;
+}
+
+// Load an audio file, reusing the pooled stream for sound effects loaded before.
+Variant AudioContentLoader::decode_from_path(const String &p_path) const {
+	auto file = FileAccess::open(p_path, FileAccess::READ);
+	if (file == nullptr){
+		EAM_LOG_ERROR("error dynamic audio not in file loader: '" + p_path + "'");
+		return FAILED;
+	}
+
+	int64_t file_size = file->get_length();
+	file->close();
+
+	bool is_music = file_size >= music_min_file_size;
+	uint64_t modified_time = FileAccess::get_modified_time(p_path);
+
+	if (!is_music){
+		Ref<AudioStream> pooled_stream = get_pooled_stream(p_path, modified_time);
+		if (pooled_stream.is_valid()){
+			return pooled_stream;
+		}
+	}
+
+	Ref<AudioStream> stream = decode_stream(p_path, is_music);
+	if (stream.is_null()){
+		EAM_LOG_ERROR("error loading dynamic audio: '" + p_path + "'");
+		return FAILED;
+	}
+
+	if (!is_music){
+		pool_stream(p_path, modified_time, file_size, stream);
+	}
+
+	return stream;
+}
+
+// Create the stream for one file. OGG and MP3 keep their compressed data and decode on playback;
+// long WAV tracks are stored as QOA so they are not held as raw PCM.
+Ref<AudioStream> AudioContentLoader::decode_stream(const String &p_path, bool is_music) const{
+	String extension = p_path.get_extension().to_lower();
+
+	if (extension == "ogg"){
+		return AudioStreamOggVorbis::load_from_file(p_path);
+	}
+
+	if (extension == "wav"){
+		Dictionary options;
+		if (is_music){
+			options["compress/mode"] = WAV_COMPRESS_QOA;
+		}
+		return AudioStreamWAV::load_from_file(p_path, options);
+	}
+
+	if (extension == "mp3"){
+		PackedByteArray data = FileAccess::get_file_as_bytes(p_path);
+		if (data.is_empty()){
+			return nullptr;
+		}
+
+		Ref<AudioStreamMP3> stream{};
+		stream.instantiate();
+		stream->set_data(data);
+		return stream;
+	}
+
+	return nullptr;
+}
+
+Ref<AudioStream> AudioContentLoader::get_pooled_stream(const String &p_path, uint64_t modified_time) const{
+	MutexLock lock{**pool_mutex};
+
+	auto entry = sfx_pool.find(p_path);
+	if (entry == sfx_pool.end() || entry->value.modified_time != modified_time){
+		return nullptr;
+	}
+
+	return entry->value.stream;
+}
+
+// Keep a sound effect stream for reuse, dropping the oldest entries beyond the pool budget.
+void AudioContentLoader::pool_stream(const String &p_path, uint64_t modified_time, int64_t size, const Ref<AudioStream> &stream) const{
+	MutexLock lock{**pool_mutex};
+
+	auto entry = sfx_pool.find(p_path);
+	if (entry != sfx_pool.end()){
+		sfx_pool_bytes -= entry->value.size;
+		sfx_pool_order.erase(p_path);
+		sfx_pool.remove(entry);
+	}
+
+	if (size > sfx_pool_budget){
+		return;
+	}
+
+	PooledStream pooled{};
+	pooled.stream = stream;
+	pooled.modified_time = modified_time;
+	pooled.size = size;
+
+	sfx_pool[p_path] = pooled;
+	sfx_pool_order.push_back(p_path);
+	sfx_pool_bytes += size;
+
+	while (sfx_pool_bytes > sfx_pool_budget && !sfx_pool_order.is_empty()){
+		String oldest_path = sfx_pool_order.front()->get();
+		sfx_pool_order.pop_front();
+
+		sfx_pool_bytes -= sfx_pool[oldest_path].size;
+		sfx_pool.erase(oldest_path);
+	}
+}
+
+void AudioContentLoader::set_music_min_file_size(int64_t p_size){
+	music_min_file_size = p_size;
+}
+
+int64_t AudioContentLoader::get_music_min_file_size() const{
+	return music_min_file_size;
+}
+
+void AudioContentLoader::set_sfx_pool_budget(int64_t p_budget){
+	sfx_pool_budget = MAX(p_budget, (int64_t)0);
+}
+
+int64_t AudioContentLoader::get_sfx_pool_budget() const{
+	return sfx_pool_budget;
+}
+
+// Release every pooled sound effect stream.
+void AudioContentLoader::clear_sfx_pool(){
+	MutexLock lock{**pool_mutex};
+	sfx_pool.clear();
+	sfx_pool_order.clear();
+	sfx_pool_bytes = 0;
+}
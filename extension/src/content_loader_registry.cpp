@@ -0,0 +1,153 @@
+#include "content_loader_registry.hpp"
+#include "asset_logger.hpp"
+
+#include "texture_content_loader.hpp"
+#include "font_content_loader.hpp"
+#include "audio_content_loader.hpp"
+#include "model_content_loader.hpp"
+#include "json_content_loader.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+// Expose ContentLoaderRegistry methods to Godot.
+void ContentLoaderRegistry::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("register_loader", "content_type", "loader"), &ContentLoaderRegistry::register_loader);
+	ClassDB::bind_method(D_METHOD("register_fallback_loader", "loader"), &ContentLoaderRegistry::register_fallback_loader);
+	ClassDB::bind_method(D_METHOD("unregister_loader", "loader"), &ContentLoaderRegistry::unregister_loader);
+
+	ClassDB::bind_method(D_METHOD("get_loader", "content_type", "file_path"), &ContentLoaderRegistry::get_loader);
+	ClassDB::bind_method(D_METHOD("get_loader_by_name", "loader_name"), &ContentLoaderRegistry::get_loader_by_name);
+	ClassDB::bind_method(D_METHOD("get_all_loaders"), &ContentLoaderRegistry::get_all_loaders);
+	ClassDB::bind_method(D_METHOD("get_registered_content_types"), &ContentLoaderRegistry::get_registered_content_types);
+}
+
+Ref<ContentLoaderRegistry> ContentLoaderRegistry::_ContentLoaderRegistrySingleton{};
+
+ContentLoaderRegistry::ContentLoaderRegistry():registry_mutex{memnew(godot::Mutex)} {}
+
+ContentLoaderRegistry::~ContentLoaderRegistry() {}
+
+// Register the loaders shipped with the extension.
+void ContentLoaderRegistry::register_default_loaders(){
+	register_loader("textures", memnew(TextureContentLoader));
+	register_loader("fonts", memnew(FontContentLoader));
+	register_loader("audio", memnew(AudioContentLoader));
+	register_loader("models", memnew(ModelContentLoader));
+
+	// JSON files are accepted for every content type.
+	register_fallback_loader(memnew(JsonContentLoader));
+}
+
+// Add a loader for a content type; later registrations take precedence.
+void ContentLoaderRegistry::register_loader(String content_type, Ref<DynamicContentLoader> loader){
+	if (loader.is_null()){
+		EAM_LOG_ERROR("Cannot register null loader for content type: " + content_type);
+		return;
+	}
+
+	MutexLock lock{**registry_mutex};
+	if (!loader_map.has(content_type)){
+		loader_map[content_type] = Vector<Ref<DynamicContentLoader>>();
+	}
+	loader_map[content_type].insert(0, loader);
+}
+
+// Add a loader that is tried for every content type after the specific ones.
+void ContentLoaderRegistry::register_fallback_loader(Ref<DynamicContentLoader> loader){
+	if (loader.is_null()){
+		EAM_LOG_ERROR("Cannot register null fallback loader");
+		return;
+	}
+
+	MutexLock lock{**registry_mutex};
+	fallback_loaders.insert(0, loader);
+}
+
+// Remove a loader from every content type it was registered for.
+void ContentLoaderRegistry::unregister_loader(Ref<DynamicContentLoader> loader){
+	MutexLock lock{**registry_mutex};
+	for (auto &[key, loaders] : loader_map){
+		loaders.erase(loader);
+	}
+	fallback_loaders.erase(loader);
+}
+
+// Find the loader for a content type that accepts the given file.
+Ref<DynamicContentLoader> ContentLoaderRegistry::get_loader(String content_type, String file_path) const{
+	MutexLock lock{**registry_mutex};
+
+	auto loaders = loader_map.find(content_type);
+	if (loaders != loader_map.end()){
+		for (const Ref<DynamicContentLoader> &loader : loaders->value){
+			if (loader->recognizes_path(file_path)){
+				return loader;
+			}
+		}
+	}
+
+	for (const Ref<DynamicContentLoader> &loader : fallback_loaders){
+		if (loader->recognizes_path(file_path)){
+			return loader;
+		}
+	}
+
+	return nullptr;
+}
+
+// Find a registered loader by its loader name.
+Ref<DynamicContentLoader> ContentLoaderRegistry::get_loader_by_name(String loader_name) const{
+	TypedArray<DynamicContentLoader> loaders = get_all_loaders();
+	for (int64_t i = 0; i < loaders.size(); i++){
+		Ref<DynamicContentLoader> loader = loaders[i];
+		if (loader->get_loader_name() == loader_name){
+			return loader;
+		}
+	}
+
+	return nullptr;
+}
+
+// Return every registered loader once.
+TypedArray<DynamicContentLoader> ContentLoaderRegistry::get_all_loaders() const{
+	MutexLock lock{**registry_mutex};
+
+	TypedArray<DynamicContentLoader> result;
+	for (const auto &[key, loaders] : loader_map){
+		for (const Ref<DynamicContentLoader> &loader : loaders){
+			if (!result.has(loader)){
+				result.append(loader);
+			}
+		}
+	}
+	for (const Ref<DynamicContentLoader> &loader : fallback_loaders){
+		if (!result.has(loader)){
+			result.append(loader);
+		}
+	}
+
+	return result;
+}
+
+// Drain background work of every registered loader.
+void ContentLoaderRegistry::wait_for_background_tasks() const{
+	TypedArray<DynamicContentLoader> loaders = get_all_loaders();
+	for (int64_t i = 0; i < loaders.size(); i++){
+		Ref<DynamicContentLoader> loader = loaders[i];
+		loader->wait_for_background_tasks();
+	}
+}
+
+// Return all content types with at least one loader.
+TypedArray<String> ContentLoaderRegistry::get_registered_content_types() const{
+	MutexLock lock{**registry_mutex};
+
+	TypedArray<String> types;
+	for (const auto &[key, loaders] : loader_map){
+		if (!loaders.is_empty()){
+			types.push_back(key);
+		}
+	}
+	return types;
+}
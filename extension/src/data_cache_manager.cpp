@@ -1,8 +1,12 @@
 #include "data_cache_manager.hpp"
+#include "asset_logger.hpp"
+#include "json_stream_reader.hpp"
+#include "xxhash64.hpp"
 
 #include <gdextension_interface.h>
 
 #include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
 #include <godot_cpp/variant/utility_functions.hpp>
 #include <godot_cpp/classes/dir_access.hpp>
 #include <godot_cpp/classes/file_access.hpp>
@@ -11,37 +15,102 @@
 #include <godot_cpp/classes/hashing_context.hpp>
 #include <godot_cpp/classes/translation.hpp>
 #include <godot_cpp/classes/translation_server.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
 #include <godot_cpp/core/class_db.hpp>
 
 using namespace godot;
 
+static constexpr const char *MANIFEST_PATH = "user://cache/manifest.eamcache";
+
+// Temporary files untouched for this many seconds belong to writes that never finished.
+static constexpr uint64_t STALE_TEMP_FILE_AGE = 10 * 60;
+
 // Expose DataCacheManager methods to Godot.
 void DataCacheManager::_bind_methods() {
 	ClassDB::bind_static_method("DataCacheManager", D_METHOD("get_file_hash", "file_path"), &DataCacheManager::get_file_hash);
 	ClassDB::bind_static_method("DataCacheManager", D_METHOD("get_string_hash", "str"), &DataCacheManager::get_string_hash);
+	ClassDB::bind_static_method("DataCacheManager", D_METHOD("compute_file_hash", "file_path", "algorithm"), &DataCacheManager::compute_file_hash);
+	ClassDB::bind_static_method("DataCacheManager", D_METHOD("compute_string_hash", "str", "algorithm"), &DataCacheManager::compute_string_hash);
+
+	ClassDB::bind_method(D_METHOD("set_hash_algorithm", "algorithm"), &DataCacheManager::set_hash_algorithm);
+	ClassDB::bind_method(D_METHOD("get_hash_algorithm"), &DataCacheManager::get_hash_algorithm);
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "hash_algorithm", PROPERTY_HINT_ENUM, "SHA256,XXH64"), "set_hash_algorithm", "get_hash_algorithm");
+
+	ClassDB::bind_method(D_METHOD("set_cache_compression", "compression"), &DataCacheManager::set_cache_compression);
+	ClassDB::bind_method(D_METHOD("get_cache_compression"), &DataCacheManager::get_cache_compression);
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "cache_compression", PROPERTY_HINT_ENUM, "None,Zstd,Deflate"), "set_cache_compression", "get_cache_compression");
+
+	ClassDB::bind_method(D_METHOD("set_storage_backend", "backend"), &DataCacheManager::set_storage_backend);
+	ClassDB::bind_method(D_METHOD("get_storage_backend"), &DataCacheManager::get_storage_backend);
+	ClassDB::bind_method(D_METHOD("get_store_stats"), &DataCacheManager::get_store_stats);
+	ClassDB::bind_method(D_METHOD("compact_store"), &DataCacheManager::compact_store);
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "storage_backend", PROPERTY_HINT_ENUM, "Files,Store"), "set_storage_backend", "get_storage_backend");
 	
 	ClassDB::bind_method(D_METHOD("index_files"), &DataCacheManager::index_files);
 	ClassDB::bind_method(D_METHOD("re_index_files"), &DataCacheManager::re_index_files);
 
+	ClassDB::bind_method(D_METHOD("save_manifest"), &DataCacheManager::save_manifest);
+	ClassDB::bind_method(D_METHOD("scrub_cache", "max_entries"), &DataCacheManager::scrub_cache, DEFVAL(-1));
+	ClassDB::bind_method(D_METHOD("start_background_scrub"), &DataCacheManager::start_background_scrub);
+	ClassDB::bind_method(D_METHOD("is_scrubbing"), &DataCacheManager::is_scrubbing);
+	ClassDB::bind_method(D_METHOD("get_unverified_count"), &DataCacheManager::get_unverified_count);
+	ClassDB::bind_method(D_METHOD("_finish_background_scrub", "verified", "corrupt"), &DataCacheManager::_finish_background_scrub);
+
 	ClassDB::bind_method(D_METHOD("cache_file", "file_path"), &DataCacheManager::cache_file);
 	ClassDB::bind_method(D_METHOD("cache_string", "str"), &DataCacheManager::cache_string);
 
+	ClassDB::bind_method(D_METHOD("set_write_behind_enabled", "enabled"), &DataCacheManager::set_write_behind_enabled);
+	ClassDB::bind_method(D_METHOD("get_write_behind_enabled"), &DataCacheManager::get_write_behind_enabled);
+	ClassDB::bind_method(D_METHOD("get_pending_write_count"), &DataCacheManager::get_pending_write_count);
+	ClassDB::bind_method(D_METHOD("flush"), &DataCacheManager::flush);
+	ClassDB::bind_method(D_METHOD("_apply_completed_writes"), &DataCacheManager::_apply_completed_writes);
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "write_behind_enabled"), "set_write_behind_enabled", "get_write_behind_enabled");
+
 	ClassDB::bind_method(D_METHOD("is_cached", "hash"), &DataCacheManager::is_cached);
 	ClassDB::bind_method(D_METHOD("get_cached_string", "hash"), &DataCacheManager::get_cached_string);
 	ClassDB::bind_method(D_METHOD("get_cached_json", "hash"), &DataCacheManager::get_cached_json);
 
+	ClassDB::bind_method(D_METHOD("set_parsed_json_budget", "budget_bytes"), &DataCacheManager::set_parsed_json_budget);
+	ClassDB::bind_method(D_METHOD("get_parsed_json_budget"), &DataCacheManager::get_parsed_json_budget);
+	ClassDB::bind_method(D_METHOD("get_parsed_json_stats"), &DataCacheManager::get_parsed_json_stats);
+	ClassDB::bind_method(D_METHOD("clear_parsed_json"), &DataCacheManager::clear_parsed_json);
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "parsed_json_budget", PROPERTY_HINT_NONE, "suffix:B"), "set_parsed_json_budget", "get_parsed_json_budget");
+
 	ClassDB::bind_method(D_METHOD("dump_hash_map"), &DataCacheManager::dump_hash_map);
 	ClassDB::bind_method(D_METHOD("get_hash_map"), &DataCacheManager::get_hash_map);
+
+	ADD_SIGNAL(MethodInfo("scrub_finished", PropertyInfo(Variant::INT, "removed_count")));
+
+	BIND_ENUM_CONSTANT(HASH_ALGORITHM_SHA256);
+	BIND_ENUM_CONSTANT(HASH_ALGORITHM_XXH64);
+
+	BIND_ENUM_CONSTANT(CACHE_COMPRESSION_NONE);
+	BIND_ENUM_CONSTANT(CACHE_COMPRESSION_ZSTD);
+	BIND_ENUM_CONSTANT(CACHE_COMPRESSION_DEFLATE);
+
+	BIND_ENUM_CONSTANT(STORAGE_BACKEND_FILES);
+	BIND_ENUM_CONSTANT(STORAGE_BACKEND_STORE);
 }
 
 
 Ref<DataCacheManager> DataCacheManager::_DataCacheManagerSingleton{};
 
-DataCacheManager::DataCacheManager() {}
+DataCacheManager::DataCacheManager():write_mutex{memnew(godot::Mutex)} {}
 
-DataCacheManager::~DataCacheManager() {}
+DataCacheManager::~DataCacheManager() {
+	if (writer_task_id != -1){
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(writer_task_id);
+	}
+
+	if (scrub_task_id != -1){
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(scrub_task_id);
+	}
+}
 
 // Scan cache directory and rebuild hash map.
+// Entries whose size and modification time match the manifest are trusted without reading them.
 void DataCacheManager::index_files(){
 	files_indexed = true;
 
@@ -50,41 +119,506 @@ void DataCacheManager::index_files(){
 
     auto cache_dir = DirAccess::open(cache_dir_str);
 	if (cache_dir == nullptr){
-		UtilityFunctions::print("Failed to open pack directory: " + cache_dir_str);
+		EAM_LOG_WARNING("Failed to open pack directory: " + cache_dir_str);
 		return;
 	}
 
+	int32_t removed_temp_files = remove_stale_temp_files(cache_dir_str);
+	if (removed_temp_files > 0){
+		EAM_LOG_INFO("Removed ", removed_temp_files, " unfinished temporary cache files.");
+	}
+
+	load_manifest();
+	HashMap<String, ManifestEntry> previous_entries = manifest_entries;
+	manifest_entries.clear();
+
 	cache_dir->list_dir_begin();
 	String cached_file = "";
 
 	while ((cached_file = cache_dir->get_next()) != ""){
-        UtilityFunctions::print("Found the following hash in cache:" + cached_file);
+        EAM_LOG_TRACE("Found the following hash in cache:" + cached_file);
 
 		if (cache_dir->current_is_dir()){
             continue;
         }
 
-        if (!cached_file.ends_with(".json")){
+        String expected_hash = get_path_key(cached_file);
+        if (expected_hash == ""){
             continue;
         }
 
-        String expected_hash = cached_file.substr(0, cached_file.length() - 5);
-        String actual_hash = get_file_hash(cache_dir_str + "/" + cached_file);
+        String file_path = cache_dir_str + "/" + cached_file;
 
-        if (expected_hash == actual_hash){
-            hashed_data_map[expected_hash] = cache_dir_str + "/" + cached_file;
+        auto previous = previous_entries.find(expected_hash);
+        if (previous != previous_entries.end()){
+            ManifestEntry metadata = read_entry_metadata(file_path);
+            metadata.algorithm = get_key_algorithm(expected_hash);
+            metadata.compression = get_path_compression(file_path);
+            if (metadata.size == previous->value.size && metadata.modified_time == previous->value.modified_time && metadata.algorithm == previous->value.algorithm && metadata.compression == previous->value.compression){
+                manifest_entries[expected_hash] = metadata;
+                hashed_data_map[expected_hash] = file_path;
+                continue;
+            }
         }
+
+        unverified_entries[expected_hash] = file_path;
+	}
+
+	// Entries in the single-file store are validated by its own index.
+	if (storage_backend == STORAGE_BACKEND_STORE || FileAccess::file_exists(cache_dir_str + "/store.eampack")){
+		if (ensure_store()){
+			PackedStringArray store_hashes = store->get_hashes();
+			for (int64_t i = 0; i < store_hashes.size(); i++){
+				if (!hashed_data_map.has(store_hashes[i])){
+					hashed_data_map[store_hashes[i]] = store->get_log_path();
+				}
+			}
+		}
+	}
+
+	// Entries that were removed or modified since the manifest was written.
+	if (manifest_entries.size() != previous_entries.size()){
+		manifest_dirty = true;
+		save_manifest();
 	}
+
+	EAM_LOG_DEBUG("Data cache indexed with ", hashed_data_map.size(), " trusted and ", unverified_entries.size(), " unverified entries");
 }
 
 // Clear cache and re-index all files.
 void DataCacheManager::re_index_files(){
 	hashed_data_map.clear();
+	unverified_entries.clear();
+	clear_parsed_json();
 	files_indexed = false;
 	index_files();
 }
 
 
+// Size and modification time of a cache file, read without touching its content.
+DataCacheManager::ManifestEntry DataCacheManager::read_entry_metadata(const String &file_path){
+	ManifestEntry entry;
+
+	auto file = FileAccess::open(file_path, FileAccess::READ);
+	if (file == nullptr){
+		return entry;
+	}
+
+	entry.size = file->get_length();
+	entry.modified_time = FileAccess::get_modified_time(file_path);
+	return entry;
+}
+
+// Keys carry their algorithm implicitly: 16 hex digits for XXH64, 64 for SHA256.
+DataCacheManager::HashAlgorithm DataCacheManager::get_key_algorithm(const String &hash){
+	return hash.length() == 16 ? HASH_ALGORITHM_XXH64 : HASH_ALGORITHM_SHA256;
+}
+
+// Re-hash the uncompressed content of a cache file with the algorithm its key was created with.
+bool DataCacheManager::verify_file_hash(const String &file_path, const String &hash){
+	HashAlgorithm algorithm = get_key_algorithm(hash);
+	if (get_path_compression(file_path) == CACHE_COMPRESSION_NONE){
+		return compute_file_hash(file_path, algorithm) == hash;
+	}
+
+	Ref<FileAccess> file = open_entry(file_path, FileAccess::READ);
+	if (file.is_null()){
+		return false;
+	}
+
+	return hash_stream(file, algorithm) == hash;
+}
+
+String DataCacheManager::get_entry_suffix(CacheCompression compression){
+	switch (compression){
+		case CACHE_COMPRESSION_ZSTD:
+			return ".json.zst";
+		case CACHE_COMPRESSION_DEFLATE:
+			return ".json.deflate";
+		default:
+			return ".json";
+	}
+}
+
+DataCacheManager::CacheCompression DataCacheManager::get_path_compression(const String &file_path){
+	if (file_path.ends_with(".json.zst")){
+		return CACHE_COMPRESSION_ZSTD;
+	}
+
+	if (file_path.ends_with(".json.deflate")){
+		return CACHE_COMPRESSION_DEFLATE;
+	}
+
+	return CACHE_COMPRESSION_NONE;
+}
+
+// Hash part of a cache file name, or an empty string for files that are not cache entries.
+String DataCacheManager::get_path_key(const String &file_name){
+	// Temporary files of unfinished writes; hash keys are hex so they never start with "tmp".
+	if (file_name.begins_with("tmp")){
+		return "";
+	}
+
+	const CacheCompression compressions[] = { CACHE_COMPRESSION_ZSTD, CACHE_COMPRESSION_DEFLATE, CACHE_COMPRESSION_NONE };
+	for (CacheCompression compression : compressions){
+		String suffix = get_entry_suffix(compression);
+		if (file_name.ends_with(suffix)){
+			return file_name.substr(0, file_name.length() - suffix.length());
+		}
+	}
+
+	return "";
+}
+
+// Delete temporary files that crashed or killed writes left under a cache directory and its subdirectories.
+// All caches name them "tmp*" or "*.tmp*"; recent ones are kept since their write may still be running.
+int32_t DataCacheManager::remove_stale_temp_files(const String &dir_path){
+	auto dir = DirAccess::open(dir_path);
+	if (dir == nullptr){
+		return 0;
+	}
+
+	uint64_t now = Time::get_singleton()->get_unix_time_from_system();
+	int32_t removed_count = 0;
+
+	dir->list_dir_begin();
+	String entry = "";
+	while ((entry = dir->get_next()) != ""){
+		String entry_path = dir_path + "/" + entry;
+		if (dir->current_is_dir()){
+			removed_count += remove_stale_temp_files(entry_path);
+			continue;
+		}
+
+		if (!entry.begins_with("tmp") && !entry.contains(".tmp")){
+			continue;
+		}
+
+		uint64_t modified_time = FileAccess::get_modified_time(entry_path);
+		if (modified_time + STALE_TEMP_FILE_AGE <= now && dir->remove(entry) == OK){
+			removed_count++;
+		}
+	}
+
+	return removed_count;
+}
+
+// Open a cache file, decompressing transparently when its suffix says it is compressed.
+Ref<FileAccess> DataCacheManager::open_entry(const String &file_path, FileAccess::ModeFlags mode){
+	switch (get_path_compression(file_path)){
+		case CACHE_COMPRESSION_ZSTD:
+			return FileAccess::open_compressed(file_path, mode, FileAccess::COMPRESSION_ZSTD);
+		case CACHE_COMPRESSION_DEFLATE:
+			return FileAccess::open_compressed(file_path, mode, FileAccess::COMPRESSION_DEFLATE);
+		default:
+			return FileAccess::open(file_path, mode);
+	}
+}
+
+// Read the uncompressed content of a cache file into one buffer.
+String DataCacheManager::read_entry_string(const String &file_path){
+	Ref<FileAccess> file = open_entry(file_path, FileAccess::READ);
+	if (file.is_null()){
+		return "";
+	}
+
+	return file->get_buffer(file->get_length()).get_string_from_utf8();
+}
+
+// Read the manifest written by a previous run; a missing or outdated manifest leaves it empty.
+void DataCacheManager::load_manifest(){
+	manifest_entries.clear();
+
+	auto file = FileAccess::open(MANIFEST_PATH, FileAccess::READ);
+	if (file == nullptr){
+		return;
+	}
+
+	if (file->get_32() != MANIFEST_MAGIC || file->get_32() != MANIFEST_VERSION){
+		EAM_LOG_WARNING("Ignoring outdated data cache manifest: " + String(MANIFEST_PATH));
+		return;
+	}
+
+	uint32_t count = file->get_32();
+	for (uint32_t i = 0; i < count; i++){
+		String hash = file->get_pascal_string();
+
+		ManifestEntry entry;
+		entry.size = file->get_64();
+		entry.modified_time = file->get_64();
+		entry.algorithm = static_cast<HashAlgorithm>(file->get_8());
+		entry.compression = static_cast<CacheCompression>(file->get_8());
+
+		if (file->eof_reached()){
+			EAM_LOG_WARNING("Truncated data cache manifest: " + String(MANIFEST_PATH));
+			manifest_entries.clear();
+			return;
+		}
+
+		manifest_entries[hash] = entry;
+	}
+}
+
+// Write the manifest through a temporary file so readers never see a partial manifest.
+void DataCacheManager::save_manifest(){
+	manifest_save_queued = false;
+
+	if (store.is_valid()){
+		if (store->needs_compaction()){
+			store->compact();
+		}
+		store->save_index();
+	}
+
+	if (!manifest_dirty){
+		return;
+	}
+
+	DirAccess::make_dir_absolute("user://cache");
+
+	String manifest_path = MANIFEST_PATH;
+	String temp_path = manifest_path + ".tmp";
+
+	auto file = FileAccess::open(temp_path, FileAccess::WRITE);
+	if (file == nullptr){
+		EAM_LOG_ERROR("Failed to open data cache manifest for writing: " + temp_path);
+		return;
+	}
+
+	file->store_32(MANIFEST_MAGIC);
+	file->store_32(MANIFEST_VERSION);
+	file->store_32(manifest_entries.size());
+	for (const auto &[hash, entry] : manifest_entries){
+		file->store_pascal_string(hash);
+		file->store_64(entry.size);
+		file->store_64(entry.modified_time);
+		file->store_8(entry.algorithm);
+		file->store_8(entry.compression);
+	}
+	file->close();
+
+	if (DirAccess::rename_absolute(temp_path, manifest_path) != OK){
+		EAM_LOG_ERROR("Failed to write data cache manifest: " + manifest_path);
+		DirAccess::remove_absolute(temp_path);
+		return;
+	}
+
+	manifest_dirty = false;
+}
+
+// Write the manifest once at the end of the frame instead of after every cached file.
+void DataCacheManager::queue_manifest_save(){
+	manifest_dirty = true;
+	if (manifest_save_queued){
+		return;
+	}
+
+	manifest_save_queued = true;
+	call_deferred("save_manifest");
+}
+
+// Mark an entry as verified and remember its metadata.
+void DataCacheManager::record_entry(const String &hash, const String &file_path){
+	hashed_data_map[hash] = file_path;
+	unverified_entries.erase(hash);
+
+	if (is_store_path(file_path)){
+		queue_manifest_save();
+		return;
+	}
+
+	ManifestEntry entry = read_entry_metadata(file_path);
+	entry.algorithm = get_key_algorithm(hash);
+	entry.compression = get_path_compression(file_path);
+	manifest_entries[hash] = entry;
+	queue_manifest_save();
+}
+
+// Drop a corrupt entry from the index and from disk.
+void DataCacheManager::discard_entry(const String &hash){
+	String file_path = "";
+	if (hashed_data_map.has(hash)){
+		file_path = hashed_data_map[hash];
+	} else if (unverified_entries.has(hash)){
+		file_path = unverified_entries[hash];
+	}
+
+	hashed_data_map.erase(hash);
+	unverified_entries.erase(hash);
+	forget_parsed_json(hash);
+	if (is_scrubbing()){
+		// A rewrite may bring the hash back before the scrub reports its old verdict.
+		scrub_stale_hashes.insert(hash);
+	}
+	if (manifest_entries.erase(hash)){
+		queue_manifest_save();
+	}
+
+	if (is_store_path(file_path)){
+		EAM_LOG_WARNING("Removing corrupt data cache entry from store: " + hash);
+		store->remove(hash);
+	} else if (file_path != ""){
+		EAM_LOG_WARNING("Removing corrupt data cache entry: " + file_path);
+		DirAccess::remove_absolute(file_path);
+	}
+}
+
+// Hash an entry that was not in the manifest on its first use.
+bool DataCacheManager::verify_entry(const String &hash){
+	String file_path = unverified_entries[hash];
+	if (!verify_entry_content(file_path, hash)){
+		discard_entry(hash);
+		return false;
+	}
+
+	record_entry(hash, file_path);
+	return true;
+}
+
+// Pick the entries to re-hash: all unverified ones first, then trusted ones round-robin.
+void DataCacheManager::collect_scrub_entries(int64_t max_entries, PackedStringArray &r_hashes, PackedStringArray &r_paths){
+	int64_t limit = max_entries < 0 ? INT64_MAX : max_entries;
+
+	for (const auto &[hash, file_path] : unverified_entries){
+		if (r_hashes.size() >= limit){
+			return;
+		}
+
+		r_hashes.push_back(hash);
+		r_paths.push_back(file_path);
+	}
+
+	LocalVector<String> trusted_hashes;
+	trusted_hashes.reserve(hashed_data_map.size());
+	for (const auto &[hash, file_path] : hashed_data_map){
+		if (!is_write_pending(hash)){
+			trusted_hashes.push_back(hash);
+		}
+	}
+
+	if (trusted_hashes.is_empty()){
+		return;
+	}
+
+	uint32_t start = scrub_cursor % trusted_hashes.size();
+	for (uint32_t i = 0; i < trusted_hashes.size() && r_hashes.size() < limit; i++){
+		const String &hash = trusted_hashes[(start + i) % trusted_hashes.size()];
+		r_hashes.push_back(hash);
+		r_paths.push_back(hashed_data_map[hash]);
+		scrub_cursor = (start + i + 1) % trusted_hashes.size();
+	}
+}
+
+// Apply re-hash results; entries removed or rewritten since they were collected are skipped.
+// Returns the number of removed entries.
+int64_t DataCacheManager::apply_scrub_results(const PackedStringArray &verified, const PackedStringArray &corrupt, const HashSet<String> &stale_hashes){
+	for (int64_t i = 0; i < verified.size(); i++){
+		const String &hash = verified[i];
+		if (unverified_entries.has(hash) && !stale_hashes.has(hash)){
+			String file_path = unverified_entries[hash];
+			record_entry(hash, file_path);
+		}
+	}
+
+	int64_t removed = 0;
+	for (int64_t i = 0; i < corrupt.size(); i++){
+		const String &hash = corrupt[i];
+		if (stale_hashes.has(hash)){
+			continue;
+		}
+
+		if (hashed_data_map.has(hash) || unverified_entries.has(hash)){
+			discard_entry(hash);
+			removed++;
+		}
+	}
+
+	return removed;
+}
+
+// Re-hash up to max_entries cached files now; -1 checks every entry.
+int64_t DataCacheManager::scrub_cache(int64_t max_entries){
+	if (!files_indexed){
+		index_files();
+	}
+
+	PackedStringArray hashes;
+	PackedStringArray paths;
+	collect_scrub_entries(max_entries, hashes, paths);
+
+	PackedStringArray verified;
+	PackedStringArray corrupt;
+	for (int64_t i = 0; i < hashes.size(); i++){
+		if (verify_entry_content(paths[i], hashes[i])){
+			verified.push_back(hashes[i]);
+		} else {
+			corrupt.push_back(hashes[i]);
+		}
+	}
+
+	return apply_scrub_results(verified, corrupt, HashSet<String>());
+}
+
+// Re-hash every cached file on a worker thread; emits scrub_finished when done.
+bool DataCacheManager::start_background_scrub(){
+	if (is_scrubbing()){
+		return false;
+	}
+
+	if (!files_indexed){
+		index_files();
+	}
+
+	PackedStringArray hashes;
+	PackedStringArray paths;
+	collect_scrub_entries(-1, hashes, paths);
+	if (hashes.is_empty()){
+		return false;
+	}
+
+	scrub_stale_hashes.clear();
+	scrub_task_id = WorkerThreadPool::get_singleton()->add_task(
+		callable_mp(this, &DataCacheManager::scrub_entries).bind(hashes, paths),
+		false,
+		"Data cache scrub"
+	);
+	return true;
+}
+
+bool DataCacheManager::is_scrubbing() const{
+	return scrub_task_id != -1;
+}
+
+int64_t DataCacheManager::get_unverified_count() const{
+	return unverified_entries.size();
+}
+
+// Runs on a worker thread; only reads files and hands the results back to the main thread.
+void DataCacheManager::scrub_entries(PackedStringArray hashes, PackedStringArray paths){
+	PackedStringArray verified;
+	PackedStringArray corrupt;
+	for (int64_t i = 0; i < hashes.size(); i++){
+		if (verify_entry_content(paths[i], hashes[i])){
+			verified.push_back(hashes[i]);
+		} else {
+			corrupt.push_back(hashes[i]);
+		}
+	}
+
+	call_deferred("_finish_background_scrub", verified, corrupt);
+}
+
+void DataCacheManager::_finish_background_scrub(PackedStringArray verified, PackedStringArray corrupt){
+	if (scrub_task_id != -1){
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(scrub_task_id);
+		scrub_task_id = -1;
+	}
+
+	int64_t removed = apply_scrub_results(verified, corrupt, scrub_stale_hashes);
+	scrub_stale_hashes.clear();
+	emit_signal("scrub_finished", removed);
+}
+
 // Get SHA256 hash of file contents.
 String DataCacheManager::get_file_hash(String file_path){
     if (!FileAccess::file_exists(file_path)){
@@ -103,15 +637,224 @@ String DataCacheManager::get_string_hash(String str){
 	return ctx->finish().hex_encode();
 }
 
+// Hash file contents with the given algorithm; SHA256 stays available for verifying distributed files.
+String DataCacheManager::compute_file_hash(String file_path, HashAlgorithm algorithm){
+	if (algorithm == HASH_ALGORITHM_SHA256){
+		return get_file_hash(file_path);
+	}
+
+	auto file = FileAccess::open(file_path, FileAccess::READ);
+	if (file == nullptr){
+		return "";
+	}
+
+	return hash_stream(file, algorithm);
+}
+
+// Hash everything left in an open file in 1 MiB chunks.
+String DataCacheManager::hash_stream(const Ref<FileAccess> &file, HashAlgorithm algorithm){
+	const int64_t chunk_size = 1024 * 1024;
+
+	if (algorithm == HASH_ALGORITHM_SHA256){
+		Ref<HashingContext> ctx = memnew(HashingContext);
+		ctx->start(HashingContext::HashType::HASH_SHA256);
+		while (file->get_position() < file->get_length()){
+			PackedByteArray chunk = file->get_buffer(chunk_size);
+			if (chunk.is_empty()){
+				break;
+			}
+			ctx->update(chunk);
+		}
+		return ctx->finish().hex_encode();
+	}
+
+	XXHash64 hasher;
+	while (file->get_position() < file->get_length()){
+		PackedByteArray chunk = file->get_buffer(chunk_size);
+		if (chunk.is_empty()){
+			break;
+		}
+		hasher.update(chunk.ptr(), chunk.size());
+	}
+
+	return String::num_uint64(hasher.digest(), 16).lpad(16, "0");
+}
+
+// Hash an in-memory buffer with the given algorithm.
+String DataCacheManager::hash_buffer(const PackedByteArray &buffer, HashAlgorithm algorithm){
+	if (algorithm == HASH_ALGORITHM_SHA256){
+		Ref<HashingContext> ctx = memnew(HashingContext);
+		ctx->start(HashingContext::HashType::HASH_SHA256);
+		ctx->update(buffer);
+		return ctx->finish().hex_encode();
+	}
+
+	return String::num_uint64(XXHash64::hash(buffer.ptr(), buffer.size()), 16).lpad(16, "0");
+}
+
+// Hash string contents with the given algorithm.
+String DataCacheManager::compute_string_hash(String str, HashAlgorithm algorithm){
+	if (algorithm == HASH_ALGORITHM_SHA256){
+		return get_string_hash(str);
+	}
+
+	CharString utf8 = str.utf8();
+	uint64_t hash = XXHash64::hash(reinterpret_cast<const uint8_t *>(utf8.get_data()), utf8.length());
+	return String::num_uint64(hash, 16).lpad(16, "0");
+}
+
+// Algorithm for keys of new entries; SHA256 by default. XXH64 hashes faster but changes the keys
+// cache_file and cache_string return, and entries cached under the other algorithm are not migrated.
+void DataCacheManager::set_hash_algorithm(HashAlgorithm algorithm){
+	hash_algorithm = algorithm;
+}
+
+DataCacheManager::HashAlgorithm DataCacheManager::get_hash_algorithm() const{
+	return hash_algorithm;
+}
+
+void DataCacheManager::set_cache_compression(CacheCompression compression){
+	cache_compression = compression;
+}
+
+DataCacheManager::CacheCompression DataCacheManager::get_cache_compression() const{
+	return cache_compression;
+}
+
+// Pending writes finish in the backend they were queued for before switching.
+void DataCacheManager::set_storage_backend(StorageBackend backend){
+	flush();
+	storage_backend = backend;
+	if (storage_backend == STORAGE_BACKEND_STORE){
+		ensure_store();
+	}
+}
+
+DataCacheManager::StorageBackend DataCacheManager::get_storage_backend() const{
+	return storage_backend;
+}
+
+Dictionary DataCacheManager::get_store_stats(){
+	if (store.is_null()){
+		return Dictionary();
+	}
+
+	return store->get_stats();
+}
+
+Error DataCacheManager::compact_store(){
+	if (store.is_null()){
+		return ERR_UNCONFIGURED;
+	}
+
+	return store->compact();
+}
+
+// Open the single-file store on first use.
+bool DataCacheManager::ensure_store(){
+	if (store.is_valid()){
+		return true;
+	}
+
+	store.instantiate();
+	if (store->open("user://cache") != OK){
+		store.unref();
+		return false;
+	}
+	return true;
+}
+
+bool DataCacheManager::is_store_path(const String &file_path) const{
+	return store.is_valid() && file_path == store->get_log_path();
+}
+
+// Location for a new entry in the configured backend; falls back to files when the store can't be opened.
+String DataCacheManager::get_new_entry_path(const String &hash) const{
+	if (storage_backend == STORAGE_BACKEND_STORE && store.is_valid()){
+		return store->get_log_path();
+	}
+
+	return "user://cache/" + hash + get_entry_suffix(cache_compression);
+}
+
+int32_t DataCacheManager::get_store_compression(CacheCompression compression){
+	switch (compression){
+		case CACHE_COMPRESSION_ZSTD:
+			return FileAccess::COMPRESSION_ZSTD;
+		case CACHE_COMPRESSION_DEFLATE:
+			return FileAccess::COMPRESSION_DEFLATE;
+		default:
+			return DataCacheStore::COMPRESSION_NONE;
+	}
+}
+
+String DataCacheManager::read_entry_content(const String &hash, const String &file_path){
+	if (is_store_path(file_path)){
+		return store->read(hash).get_string_from_utf8();
+	}
+
+	return read_entry_string(file_path);
+}
+
+// Re-hash an entry from whichever backend holds it; safe to call from the scrub worker.
+bool DataCacheManager::verify_entry_content(const String &file_path, const String &hash){
+	if (is_store_path(file_path)){
+		return hash_buffer(store->read(hash), get_key_algorithm(hash)) == hash;
+	}
+
+	return verify_file_hash(file_path, hash);
+}
+
+// Write one entry to the backend its path belongs to; runs on the background writer.
+Error DataCacheManager::write_entry(const String &hash, const String &file_path, const String &content, CacheCompression compression){
+	if (is_store_path(file_path)){
+		return store->append(hash, content.to_utf8_buffer(), get_store_compression(compression));
+	}
+
+	return write_entry_file(file_path, content);
+}
+
 
 // Cache file contents by hashing it.
+// The file is hashed and validated in chunks. File entries are copied in chunks as well; store records
+// are compressed as one block, so the store backend holds the file in memory while appending it.
 String DataCacheManager::cache_file(String file_path){
-	String raw_data = FileAccess::get_file_as_string(file_path);
-	if (raw_data == ""){
-		UtilityFunctions::print("Failed to read file: " + file_path);
+	if (!files_indexed){
+		index_files();
+	}
+
+	String hash = compute_file_hash(file_path, hash_algorithm);
+	if (hash == ""){
+		EAM_LOG_ERROR("Failed to read file: " + file_path);
 		return "";
 	}
-	return cache_string(raw_data);
+
+	if (is_cached(hash)){
+		return hash;
+	}
+
+	if (JsonStreamReader::validate_file(file_path) != OK){
+		return "";
+	}
+
+	String cache_dir_str = "user://cache";
+	DirAccess::make_dir_absolute(cache_dir_str);
+
+	String cache_file_path = get_new_entry_path(hash);
+	Error err = OK;
+	if (is_store_path(cache_file_path)){
+		err = store->append(hash, FileAccess::get_file_as_bytes(file_path), get_store_compression(cache_compression));
+	} else {
+		err = copy_entry_file(file_path, cache_file_path);
+	}
+
+	if (err != OK){
+		EAM_LOG_ERROR("Failed to open cache file for writing: " + cache_file_path);
+		return "";
+	}
+
+	record_entry(hash, cache_file_path);
+	return hash;
 }
 
 // Cache string by computing hash and storing.
@@ -121,7 +864,7 @@ String DataCacheManager::cache_string(String str){
 	}
 
 	// Hash string; return early if cache exists.
-	String hash = get_string_hash(str);
+	String hash = compute_string_hash(str, hash_algorithm);
 	if (hash == ""){
 		return "";
 	}
@@ -130,33 +873,232 @@ String DataCacheManager::cache_string(String str){
 		return hash;
 	}
 
-	// Validate JSON before caching.
-	JSON* json = memnew(JSON);
-	Error error = json->parse(str);
-	if (error != OK){
-		UtilityFunctions::print("JSON Parse Error: ", json->get_error_message(), " in ", str, " at line ", json->get_error_line());
+	// Validate JSON before caching, without building the parsed tree.
+	Ref<JsonStreamReader> reader = memnew(JsonStreamReader);
+	reader->open_buffer(str.to_utf8_buffer());
+	if (reader->validate() != OK){
+		EAM_LOG_ERROR("JSON Parse Error: ", reader->get_error_message(), " in ", str, " at line ", reader->get_error_line());
 		return "";
 	}
-	memdelete(json);
 
-	// Write data to cache file.
-	String cache_dir_str = "user://cache";
-	DirAccess::make_dir_absolute(cache_dir_str);
+	// Write data to cache file, on the background writer unless write-behind is disabled.
+	String cache_file_path = get_new_entry_path(hash);
+	if (write_behind_enabled){
+		queue_write(hash, cache_file_path, str, cache_compression);
+		return hash;
+	}
 
-	String cache_file_path = cache_dir_str + "/" + hash + ".json";
-	auto cache_file = FileAccess::open(cache_file_path, FileAccess::WRITE);
-	if (cache_file == nullptr){
-		UtilityFunctions::print("Failed to open cache file for writing: " + cache_file_path);
+	if (write_entry(hash, cache_file_path, str, cache_compression) != OK){
+		EAM_LOG_ERROR("Failed to open cache file for writing: " + cache_file_path);
 		return "";
 	}
 
-	cache_file->store_string(str);
-	cache_file->close();
-
-	hashed_data_map[hash] = cache_file_path;
+	record_entry(hash, cache_file_path);
 	return hash;
 }
 
+void DataCacheManager::set_write_behind_enabled(bool enabled){
+	write_behind_enabled = enabled;
+	if (!enabled){
+		flush();
+	}
+}
+
+bool DataCacheManager::get_write_behind_enabled() const{
+	return write_behind_enabled;
+}
+
+int64_t DataCacheManager::get_pending_write_count(){
+	MutexLock lock{**write_mutex};
+	return pending_contents.size();
+}
+
+// Write a cache file through a temporary file so readers never see a partial entry.
+Error DataCacheManager::write_entry_file(const String &file_path, const String &content){
+	DirAccess::make_dir_absolute(file_path.get_base_dir());
+
+	// The temporary name keeps the entry suffix so it is opened with the same compression.
+	String temp_path = file_path.get_base_dir() + "/tmp" + String::num_uint64(OS::get_singleton()->get_thread_caller_id()) + "_" + file_path.get_file();
+	auto file = open_entry(temp_path, FileAccess::WRITE);
+	if (file == nullptr){
+		return ERR_FILE_CANT_WRITE;
+	}
+
+	bool stored = file->store_string(content) && file->get_error() == OK;
+	file->close();
+
+	Error err = stored ? DirAccess::rename_absolute(temp_path, file_path) : ERR_FILE_CANT_WRITE;
+	if (err != OK){
+		DirAccess::remove_absolute(temp_path);
+	}
+	return err;
+}
+
+// Copy a source file into a cache entry in chunks, compressing it on the way when the entry is compressed.
+Error DataCacheManager::copy_entry_file(const String &source_path, const String &file_path){
+	DirAccess::make_dir_absolute(file_path.get_base_dir());
+
+	String temp_path = file_path.get_base_dir() + "/tmp" + String::num_uint64(OS::get_singleton()->get_thread_caller_id()) + "_" + file_path.get_file();
+	Error err = OK;
+
+	if (get_path_compression(file_path) == CACHE_COMPRESSION_NONE){
+		err = DirAccess::copy_absolute(source_path, temp_path);
+	} else {
+		auto source = FileAccess::open(source_path, FileAccess::READ);
+		auto file = open_entry(temp_path, FileAccess::WRITE);
+		if (source == nullptr || file == nullptr){
+			err = ERR_FILE_CANT_WRITE;
+		} else {
+			const int64_t chunk_size = 1024 * 1024;
+			while (source->get_position() < source->get_length()){
+				PackedByteArray chunk = source->get_buffer(chunk_size);
+				if (chunk.is_empty()){
+					err = ERR_FILE_CANT_READ;
+					break;
+				}
+				if (!file->store_buffer(chunk) || file->get_error() != OK){
+					err = ERR_FILE_CANT_WRITE;
+					break;
+				}
+			}
+		}
+
+		// Closing finishes the compressed stream; the temp file is removed below on any error.
+		if (file != nullptr){
+			file->close();
+		}
+	}
+
+	if (err == OK){
+		err = DirAccess::rename_absolute(temp_path, file_path);
+	}
+	if (err != OK){
+		DirAccess::remove_absolute(temp_path);
+	}
+	return err;
+}
+
+// Make the entry visible right away and hand the file write to the background writer.
+void DataCacheManager::queue_write(const String &hash, const String &file_path, const String &content, CacheCompression compression){
+	hashed_data_map[hash] = file_path;
+	unverified_entries.erase(hash);
+
+	MutexLock lock{**write_mutex};
+	pending_contents[hash] = content;
+
+	PendingWrite write;
+	write.hash = hash;
+	write.path = file_path;
+	write.content = content;
+	write.compression = compression;
+	write_queue.push_back(write);
+
+	if (writer_running){
+		return;
+	}
+
+	// A finished writer task still has to be waited on before its id is released.
+	if (writer_task_id != -1){
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(writer_task_id);
+	}
+
+	writer_running = true;
+	writer_task_id = WorkerThreadPool::get_singleton()->add_task(
+		callable_mp(this, &DataCacheManager::process_write_queue),
+		false,
+		"Data cache writer"
+	);
+}
+
+// Runs on a worker thread; writes queued entries in batches until the queue is empty.
+void DataCacheManager::process_write_queue(){
+	while (true){
+		LocalVector<PendingWrite> batch;
+		{
+			MutexLock lock{**write_mutex};
+			if (write_queue.is_empty()){
+				writer_running = false;
+				return;
+			}
+
+			batch = write_queue;
+			write_queue.clear();
+		}
+
+		LocalVector<CompletedWrite> results;
+		for (uint32_t i = 0; i < batch.size(); i++){
+			const PendingWrite &write = batch[i];
+			CompletedWrite result;
+			result.hash = write.hash;
+			result.path = write.path;
+			result.error = write_entry(write.hash, write.path, write.content, write.compression);
+			results.push_back(result);
+		}
+
+		MutexLock lock{**write_mutex};
+		for (uint32_t i = 0; i < results.size(); i++){
+			pending_contents.erase(results[i].hash);
+			completed_writes.push_back(results[i]);
+		}
+
+		if (!completion_queued){
+			completion_queued = true;
+			call_deferred("_apply_completed_writes");
+		}
+	}
+}
+
+// Record finished writes in the manifest, or drop entries whose write failed.
+void DataCacheManager::apply_completed_writes(){
+	LocalVector<CompletedWrite> results;
+	{
+		MutexLock lock{**write_mutex};
+		results = completed_writes;
+		completed_writes.clear();
+		completion_queued = false;
+	}
+
+	for (uint32_t i = 0; i < results.size(); i++){
+		const CompletedWrite &result = results[i];
+		if (result.error != OK){
+			EAM_LOG_ERROR("Failed to write cache file: " + result.path);
+			hashed_data_map.erase(result.hash);
+			forget_parsed_json(result.hash);
+			if (is_scrubbing()){
+				scrub_stale_hashes.insert(result.hash);
+			}
+			continue;
+		}
+
+		record_entry(result.hash, result.path);
+	}
+}
+
+void DataCacheManager::_apply_completed_writes(){
+	apply_completed_writes();
+}
+
+bool DataCacheManager::is_write_pending(const String &hash){
+	MutexLock lock{**write_mutex};
+	return pending_contents.has(hash);
+}
+
+// Block until every queued cache write is on disk.
+void DataCacheManager::flush(){
+	int64_t task_id = -1;
+	{
+		MutexLock lock{**write_mutex};
+		task_id = writer_task_id;
+		writer_task_id = -1;
+	}
+
+	if (task_id != -1){
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	}
+
+	apply_completed_writes();
+}
+
 
 // Check if hash is in cache.
 bool DataCacheManager::is_cached(String hash){
@@ -164,7 +1106,15 @@ bool DataCacheManager::is_cached(String hash){
 		index_files();
 	}
 
-	return hashed_data_map.find(hash) != hashed_data_map.end();
+	if (hashed_data_map.find(hash) != hashed_data_map.end()){
+		return true;
+	}
+
+	if (unverified_entries.has(hash)){
+		return verify_entry(hash);
+	}
+
+	return false;
 }
 
 // Retrieve cached string by hash.
@@ -177,11 +1127,32 @@ String DataCacheManager::get_cached_string(String hash){
 		return "";
 	}
 
-	return FileAccess::get_file_as_string(hashed_data_map[hash]);
+	{
+		MutexLock lock{**write_mutex};
+		auto pending = pending_contents.find(hash);
+		if (pending != pending_contents.end()){
+			return pending->value;
+		}
+	}
+
+	return read_entry_content(hash, hashed_data_map[hash]);
 }
 
 // Parse and return cached JSON by hash.
+// Parsed data is kept in a size bounded LRU and shared read-only; duplicate it before modifying.
 Ref<JSON> DataCacheManager::get_cached_json(String hash){
+	auto cached = parsed_json.find(hash);
+	if (cached != parsed_json.end()){
+		parsed_json_hits++;
+		parsed_json_lru.move_to_front(cached->value.lru_element);
+
+		Ref<JSON> json = memnew(JSON);
+		json->set_data(cached->value.data);
+		return json;
+	}
+
+	parsed_json_misses++;
+
 	String cached_string = get_cached_string(hash);
 	if (cached_string == ""){
 		return nullptr;
@@ -190,13 +1161,94 @@ Ref<JSON> DataCacheManager::get_cached_json(String hash){
 	Ref<JSON> json = memnew(JSON);
 	Error error = json->parse(cached_string);
 	if (error != OK){
-		UtilityFunctions::print("JSON Parse Error: ", json->get_error_message(), " in ", cached_string, " at line ", json->get_error_line());
+		EAM_LOG_ERROR("JSON Parse Error: ", json->get_error_message(), " in ", cached_string, " at line ", json->get_error_line());
 		return nullptr;
 	}
 
+	// The text length stands in for the parsed size; entries larger than the whole budget are not kept.
+	int64_t size = cached_string.length();
+	if (size > parsed_json_budget){
+		return json;
+	}
+
+	Variant data = json->get_data();
+	make_read_only(data);
+
+	ParsedJsonEntry entry;
+	entry.data = data;
+	entry.size = size;
+	entry.lru_element = parsed_json_lru.push_front(hash);
+	parsed_json[hash] = entry;
+	parsed_json_bytes += size;
+
+	evict_parsed_json();
 	return json;
 }
 
+void DataCacheManager::set_parsed_json_budget(int64_t budget_bytes){
+	parsed_json_budget = MAX(budget_bytes, 0);
+	evict_parsed_json();
+}
+
+int64_t DataCacheManager::get_parsed_json_budget() const{
+	return parsed_json_budget;
+}
+
+Dictionary DataCacheManager::get_parsed_json_stats() const{
+	Dictionary stats;
+	stats["budget"] = parsed_json_budget;
+	stats["resident_bytes"] = parsed_json_bytes;
+	stats["resident_count"] = parsed_json_lru.size();
+	stats["hits"] = parsed_json_hits;
+	stats["misses"] = parsed_json_misses;
+	stats["evictions"] = parsed_json_evictions;
+	return stats;
+}
+
+void DataCacheManager::clear_parsed_json(){
+	parsed_json.clear();
+	parsed_json_lru.clear();
+	parsed_json_bytes = 0;
+}
+
+void DataCacheManager::forget_parsed_json(const String &hash){
+	auto cached = parsed_json.find(hash);
+	if (cached == parsed_json.end()){
+		return;
+	}
+
+	parsed_json_bytes -= cached->value.size;
+	parsed_json_lru.erase(cached->value.lru_element);
+	parsed_json.erase(hash);
+}
+
+// Drop least recently used parsed results until the budget is met.
+void DataCacheManager::evict_parsed_json(){
+	while (parsed_json_bytes > parsed_json_budget && parsed_json_lru.size() > 0){
+		String hash = parsed_json_lru.back()->get();
+		forget_parsed_json(hash);
+		parsed_json_evictions++;
+	}
+}
+
+// Lock every array and dictionary in a parsed tree so shared results can't be modified.
+void DataCacheManager::make_read_only(const Variant &value){
+	if (value.get_type() == Variant::DICTIONARY){
+		Dictionary dictionary = value;
+		Array values = dictionary.values();
+		for (int64_t i = 0; i < values.size(); i++){
+			make_read_only(values[i]);
+		}
+		dictionary.make_read_only();
+	} else if (value.get_type() == Variant::ARRAY){
+		Array array = value;
+		for (int64_t i = 0; i < array.size(); i++){
+			make_read_only(array[i]);
+		}
+		array.make_read_only();
+	}
+}
+
 
 // Print all cached items and their paths.
 void DataCacheManager::dump_hash_map() {
@@ -0,0 +1,402 @@
+#include "data_cache_store.hpp"
+#include "asset_logger.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
+
+using namespace godot;
+
+// Compaction only pays off once the log holds a meaningful amount of dead data.
+static constexpr uint64_t MIN_COMPACTION_DEAD_BYTES = 1024 * 1024;
+
+void DataCacheStore::_bind_methods() {}
+
+DataCacheStore::DataCacheStore():store_mutex{memnew(godot::Mutex)} {}
+
+DataCacheStore::~DataCacheStore() {
+	close();
+}
+
+// Size of a record in the log: magic, hash, compression, both sizes and the payload.
+uint64_t DataCacheStore::get_record_size(const String &hash, const Record &record){
+	return sizeof(uint32_t) + sizeof(uint32_t) + hash.utf8().length() + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint64_t) + record.stored_size;
+}
+
+// Open or create the log in a directory; records appended after the last saved index are recovered from the log.
+Error DataCacheStore::open(const String &directory){
+	MutexLock lock{**store_mutex};
+
+	DirAccess::make_dir_recursive_absolute(directory);
+	log_path = directory + "/store.eampack";
+	index_path = directory + "/store.eamidx";
+
+	if (!FileAccess::file_exists(log_path)){
+		Ref<FileAccess> created = FileAccess::open(log_path, FileAccess::WRITE);
+		if (created.is_null()){
+			EAM_LOG_ERROR("Failed to create data cache store: " + log_path);
+			return ERR_FILE_CANT_WRITE;
+		}
+	}
+
+	log_file = FileAccess::open(log_path, FileAccess::READ_WRITE);
+	if (log_file.is_null()){
+		EAM_LOG_ERROR("Failed to open data cache store: " + log_path);
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	if (!load_index()){
+		records.clear();
+		live_bytes = 0;
+		log_end = 0;
+	}
+
+	uint64_t indexed_end = log_end;
+	scan_log(log_end);
+	if (log_end != indexed_end){
+		index_dirty = true;
+	}
+
+	EAM_LOG_DEBUG("Data cache store opened with ", records.size(), " entries");
+	return OK;
+}
+
+void DataCacheStore::close(){
+	MutexLock lock{**store_mutex};
+
+	if (log_file.is_valid()){
+		save_index_locked();
+		log_file->close();
+		log_file.unref();
+	}
+
+	records.clear();
+	live_bytes = 0;
+	log_end = 0;
+}
+
+bool DataCacheStore::is_open() const{
+	return log_file.is_valid();
+}
+
+String DataCacheStore::get_log_path() const{
+	return log_path;
+}
+
+// Read the saved index; fails when it is missing, outdated or describes more log than exists.
+bool DataCacheStore::load_index(){
+	records.clear();
+	live_bytes = 0;
+	log_end = 0;
+
+	Ref<FileAccess> file = FileAccess::open(index_path, FileAccess::READ);
+	if (file.is_null()){
+		return false;
+	}
+
+	if (file->get_32() != INDEX_MAGIC || file->get_32() != INDEX_VERSION){
+		EAM_LOG_WARNING("Ignoring outdated data cache store index: " + index_path);
+		return false;
+	}
+
+	uint64_t indexed_end = file->get_64();
+	if (indexed_end > log_file->get_length()){
+		EAM_LOG_WARNING("Data cache store index is ahead of its log, rebuilding: " + index_path);
+		return false;
+	}
+
+	uint32_t count = file->get_32();
+	for (uint32_t i = 0; i < count; i++){
+		String hash = file->get_pascal_string();
+
+		Record record;
+		record.data_offset = file->get_64();
+		record.stored_size = file->get_64();
+		record.raw_size = file->get_64();
+		record.compression = static_cast<int32_t>(file->get_32());
+
+		if (file->eof_reached()){
+			EAM_LOG_WARNING("Truncated data cache store index: " + index_path);
+			records.clear();
+			live_bytes = 0;
+			return false;
+		}
+
+		records[hash] = record;
+		live_bytes += get_record_size(hash, record);
+	}
+
+	log_end = indexed_end;
+	return true;
+}
+
+// Add records found after the given offset and apply tombstones; stops at the first incomplete or foreign record.
+void DataCacheStore::scan_log(uint64_t from){
+	uint64_t length = log_file->get_length();
+	log_file->seek(from);
+	log_end = from;
+
+	while (log_end + sizeof(uint32_t) <= length){
+		if (log_file->get_32() != RECORD_MAGIC){
+			break;
+		}
+
+		String hash = log_file->get_pascal_string();
+
+		Record record;
+		record.compression = static_cast<int32_t>(log_file->get_32());
+		record.raw_size = log_file->get_64();
+		record.stored_size = log_file->get_64();
+		record.data_offset = log_file->get_position();
+
+		if (log_file->eof_reached() || record.data_offset + record.stored_size > length){
+			break;
+		}
+
+		auto existing = records.find(hash);
+		if (existing != records.end()){
+			live_bytes -= get_record_size(hash, existing->value);
+			records.remove(existing);
+		}
+
+		if (record.compression != COMPRESSION_TOMBSTONE){
+			records[hash] = record;
+			live_bytes += get_record_size(hash, record);
+		}
+
+		log_end = record.data_offset + record.stored_size;
+		log_file->seek(log_end);
+	}
+
+	if (log_end < length){
+		EAM_LOG_WARNING("Ignoring incomplete data at the end of the data cache store: " + log_path);
+	}
+}
+
+// Write one record at the current position of a log file.
+Error DataCacheStore::write_record(const Ref<FileAccess> &file, const String &hash, const Record &record, const PackedByteArray &stored, Record &r_written){
+	file->store_32(RECORD_MAGIC);
+	file->store_pascal_string(hash);
+	file->store_32(static_cast<uint32_t>(record.compression));
+	file->store_64(record.raw_size);
+	file->store_64(stored.size());
+
+	r_written = record;
+	r_written.data_offset = file->get_position();
+	r_written.stored_size = stored.size();
+
+	if (!file->store_buffer(stored)){
+		return ERR_FILE_CANT_WRITE;
+	}
+
+	return file->get_error() == OK ? OK : ERR_FILE_CANT_WRITE;
+}
+
+bool DataCacheStore::has(const String &hash){
+	MutexLock lock{**store_mutex};
+	return records.has(hash);
+}
+
+PackedStringArray DataCacheStore::get_hashes(){
+	MutexLock lock{**store_mutex};
+
+	PackedStringArray hashes;
+	for (const auto &[hash, record] : records){
+		hashes.push_back(hash);
+	}
+	return hashes;
+}
+
+// Append an entry to the end of the log; entries are content addressed so existing hashes are kept.
+Error DataCacheStore::append(const String &hash, const PackedByteArray &data, int32_t compression){
+	PackedByteArray stored = compression == COMPRESSION_NONE ? data : data.compress(static_cast<FileAccess::CompressionMode>(compression));
+
+	MutexLock lock{**store_mutex};
+	if (log_file.is_null()){
+		return ERR_FILE_CANT_WRITE;
+	}
+
+	if (records.has(hash)){
+		return OK;
+	}
+
+	Record record;
+	record.raw_size = data.size();
+	record.compression = compression;
+
+	log_file->seek(log_end);
+
+	Record written;
+	Error err = write_record(log_file, hash, record, stored, written);
+	if (err != OK){
+		EAM_LOG_ERROR("Failed to append to data cache store: " + log_path);
+		// The next append overwrites the partial record.
+		return err;
+	}
+	log_file->flush();
+
+	records[hash] = written;
+	live_bytes += get_record_size(hash, written);
+	log_end = written.data_offset + written.stored_size;
+	index_dirty = true;
+	return OK;
+}
+
+// Read and decompress an entry; returns an empty buffer when the hash is unknown.
+PackedByteArray DataCacheStore::read(const String &hash){
+	MutexLock lock{**store_mutex};
+
+	auto record = records.find(hash);
+	if (record == records.end() || log_file.is_null()){
+		return PackedByteArray();
+	}
+
+	log_file->seek(record->value.data_offset);
+	PackedByteArray stored = log_file->get_buffer(record->value.stored_size);
+	if (record->value.compression == COMPRESSION_NONE){
+		return stored;
+	}
+
+	return stored.decompress(record->value.raw_size, static_cast<FileAccess::CompressionMode>(record->value.compression));
+}
+
+// Forget an entry and append a tombstone for it; its bytes stay in the log until the next compaction.
+void DataCacheStore::remove(const String &hash){
+	MutexLock lock{**store_mutex};
+
+	auto record = records.find(hash);
+	if (record == records.end()){
+		return;
+	}
+
+	live_bytes -= get_record_size(hash, record->value);
+	records.remove(record);
+	index_dirty = true;
+
+	if (log_file.is_null()){
+		return;
+	}
+
+	Record tombstone;
+	tombstone.compression = COMPRESSION_TOMBSTONE;
+
+	log_file->seek(log_end);
+	Record written;
+	if (write_record(log_file, hash, tombstone, PackedByteArray(), written) != OK){
+		EAM_LOG_ERROR("Failed to record removal in data cache store: " + log_path);
+		return;
+	}
+	log_file->flush();
+	log_end = written.data_offset;
+}
+
+Error DataCacheStore::save_index(){
+	MutexLock lock{**store_mutex};
+	return save_index_locked();
+}
+
+// Write the index through a temporary file; caller must hold store_mutex.
+Error DataCacheStore::save_index_locked(){
+	if (!index_dirty){
+		return OK;
+	}
+
+	String temp_path = index_path + ".tmp";
+	Ref<FileAccess> file = FileAccess::open(temp_path, FileAccess::WRITE);
+	if (file.is_null()){
+		EAM_LOG_ERROR("Failed to open data cache store index for writing: " + temp_path);
+		return ERR_FILE_CANT_WRITE;
+	}
+
+	file->store_32(INDEX_MAGIC);
+	file->store_32(INDEX_VERSION);
+	file->store_64(log_end);
+	file->store_32(records.size());
+	for (const auto &[hash, record] : records){
+		file->store_pascal_string(hash);
+		file->store_64(record.data_offset);
+		file->store_64(record.stored_size);
+		file->store_64(record.raw_size);
+		file->store_32(static_cast<uint32_t>(record.compression));
+	}
+	file->close();
+
+	Error err = DirAccess::rename_absolute(temp_path, index_path);
+	if (err != OK){
+		DirAccess::remove_absolute(temp_path);
+		return err;
+	}
+
+	index_dirty = false;
+	return OK;
+}
+
+// Worth compacting once removed records and tombstones take up more space than live ones.
+bool DataCacheStore::needs_compaction(){
+	MutexLock lock{**store_mutex};
+
+	uint64_t dead_bytes = log_end - MIN(live_bytes, log_end);
+	return dead_bytes >= MIN_COMPACTION_DEAD_BYTES && dead_bytes > live_bytes;
+}
+
+// Rewrite the log with live records only, then swap it in and save a fresh index.
+Error DataCacheStore::compact(){
+	MutexLock lock{**store_mutex};
+	if (log_file.is_null()){
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	String temp_path = log_path + ".tmp";
+	Ref<FileAccess> compacted = FileAccess::open(temp_path, FileAccess::WRITE);
+	if (compacted.is_null()){
+		EAM_LOG_ERROR("Failed to open data cache store for compaction: " + temp_path);
+		return ERR_FILE_CANT_WRITE;
+	}
+
+	HashMap<String, Record> compacted_records;
+	for (const auto &[hash, record] : records){
+		log_file->seek(record.data_offset);
+		PackedByteArray stored = log_file->get_buffer(record.stored_size);
+
+		Record written;
+		if (write_record(compacted, hash, record, stored, written) != OK){
+			EAM_LOG_ERROR("Failed to compact data cache store: " + log_path);
+			compacted->close();
+			DirAccess::remove_absolute(temp_path);
+			return ERR_FILE_CANT_WRITE;
+		}
+		compacted_records[hash] = written;
+	}
+
+	uint64_t compacted_end = compacted->get_position();
+	compacted->close();
+
+	// Without an index a crash before the new one is saved falls back to scanning the compacted log.
+	DirAccess::remove_absolute(index_path);
+
+	log_file->close();
+	Error err = DirAccess::rename_absolute(temp_path, log_path);
+	log_file = FileAccess::open(log_path, FileAccess::READ_WRITE);
+	if (err != OK || log_file.is_null()){
+		EAM_LOG_ERROR("Failed to replace data cache store after compaction: " + log_path);
+		DirAccess::remove_absolute(temp_path);
+		return err != OK ? err : ERR_FILE_CANT_OPEN;
+	}
+
+	EAM_LOG_INFO("Compacted data cache store from ", log_end, " to ", compacted_end, " bytes");
+
+	records = compacted_records;
+	log_end = compacted_end;
+	live_bytes = compacted_end;
+	index_dirty = true;
+	return save_index_locked();
+}
+
+Dictionary DataCacheStore::get_stats(){
+	MutexLock lock{**store_mutex};
+
+	Dictionary stats;
+	stats["entries"] = records.size();
+	stats["live_bytes"] = live_bytes;
+	stats["log_bytes"] = log_end;
+	return stats;
+}
@@ -1,15 +1,23 @@
 #include "dynamic_asset_indexer.hpp"
+#include "asset_logger.hpp"
 
 #include "indexing_functions.cpp"
 
 #include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/templates/hashfuncs.hpp>
+
+// Files are fingerprinted in chunks of this size so large files are never read at once.
+static constexpr int64_t FINGERPRINT_CHUNK_SIZE = 1024 * 1024;
 
 // Expose DynamicAssetIndexer methods to Godot.
 void DynamicAssetIndexer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("index_files"), &DynamicAssetIndexer::index_files);
 	ClassDB::bind_method(D_METHOD("re_index_files"), &DynamicAssetIndexer::re_index_files);
+	ClassDB::bind_method(D_METHOD("get_index_generation"), &DynamicAssetIndexer::get_index_generation);
 	ClassDB::bind_method(D_METHOD("get_asset_path"), &DynamicAssetIndexer::get_asset_path);
 	ClassDB::bind_method(D_METHOD("get_resource_path"), &DynamicAssetIndexer::get_resource_path);
+	ClassDB::bind_method(D_METHOD("get_content_fingerprint", "file_path"), &DynamicAssetIndexer::get_content_fingerprint);
 	ClassDB::bind_method(D_METHOD("dump_asset_map"), &DynamicAssetIndexer::dump_asset_map);
 	ClassDB::bind_method(D_METHOD("get_asset_map"), &DynamicAssetIndexer::get_asset_map);
 }
@@ -30,23 +38,23 @@ void DynamicAssetIndexer::index_files(){
 	files_indexed = true;
 
 	// Index res://default_assets as base pack first.
-	UtilityFunctions::print("Indexing asset pack res://default_assets");
+	EAM_LOG_INFO("Indexing asset pack res://default_assets");
 	_index_asset_pack("res://default_assets", asset_map);
 
 	// Index external packs; will overwrite defaults.
 	auto packs_dir = DirAccess::open("user://external"); 
 	if (packs_dir == nullptr){
-		UtilityFunctions::print("Failed to open external directory");
+		EAM_LOG_WARNING("Failed to open external directory");
 		return;
 	}
 
 	packs_dir->list_dir_begin();
 	String asset_pack = packs_dir->get_next();
 
-	UtilityFunctions::print("Indexing asset packs from user://external");
+	EAM_LOG_INFO("Indexing asset packs from user://external");
 
 	while (asset_pack != ""){
-		UtilityFunctions::print("Indexing asset pack: " + asset_pack);
+		EAM_LOG_INFO("Indexing asset pack: " + asset_pack);
 
 		String pack_path = "user://external/" + asset_pack;
 		if (packs_dir->current_is_dir()){
@@ -62,12 +70,19 @@ void DynamicAssetIndexer::re_index_files(){
 	{
 		MutexLock lock{**index_mutex};
 		asset_map.clear();
+		content_fingerprints.clear();
 		files_indexed = false;
+		index_generation++;
 	}
 	
 	index_files();
 }
 
+// Incremented on every re-index; identifies which index a resolved path came from.
+uint64_t DynamicAssetIndexer::get_index_generation() const{
+	return index_generation.load();
+}
+
 // Get file path for asset identifier.
 String DynamicAssetIndexer::get_asset_path(Ref<Identifier> asset_id){
 	index_files();
@@ -75,7 +90,7 @@ String DynamicAssetIndexer::get_asset_path(Ref<Identifier> asset_id){
 	String asset_id_string = asset_id->to_string();	
 
 	if (!asset_map.has(asset_id_string)){
-		UtilityFunctions::print("Asset not found in index: " + asset_id->to_string());
+		EAM_LOG_WARNING("Asset not found in index: " + asset_id->to_string());
 		return "";
 	}
 	
@@ -88,13 +103,13 @@ TypedArray<String> DynamicAssetIndexer::get_resource_path(String raw_resource_pa
 
 	auto resource_id = Identifier::for_resource(raw_resource_path);
 	if (!resource_id->is_valid()){
-		UtilityFunctions::print("Got invalid Identidier: '" + raw_resource_path + "'");
+		EAM_LOG_WARNING("Got invalid Identidier: '" + raw_resource_path + "'");
 		return result;
 	}
 
 	auto fixed_path = get_asset_path(resource_id);
 	if (fixed_path == ""){
-		UtilityFunctions::print("Asset not found in AssetIndexer: '" + raw_resource_path + "'");
+		EAM_LOG_WARNING("Asset not found in AssetIndexer: '" + raw_resource_path + "'");
 		return result;
 	}
 
@@ -104,6 +119,50 @@ TypedArray<String> DynamicAssetIndexer::get_resource_path(String raw_resource_pa
 	return result;
 }
 
+// Fingerprint of a file's content; equal fingerprints mean the files have the same size and,
+// with high probability, identical bytes. Computed on first request and kept until the next re-index.
+String DynamicAssetIndexer::get_content_fingerprint(String file_path){
+	{
+		MutexLock lock{**index_mutex};
+		if (content_fingerprints.has(file_path)){
+			return content_fingerprints[file_path];
+		}
+	}
+
+	String fingerprint = compute_file_fingerprint(file_path);
+	if (fingerprint == ""){
+		return "";
+	}
+
+	MutexLock lock{**index_mutex};
+	content_fingerprints[file_path] = fingerprint;
+	return fingerprint;
+}
+
+// File size followed by two differently seeded murmur3-32 hashes of the content.
+// Files of different size never compare equal; equal sizes and hashes are a probabilistic match.
+String DynamicAssetIndexer::compute_file_fingerprint(String file_path){
+	auto file = FileAccess::open(file_path, FileAccess::READ);
+	if (file == nullptr){
+		return "";
+	}
+
+	uint32_t hash_low = HASH_MURMUR3_SEED;
+	uint32_t hash_high = ~HASH_MURMUR3_SEED;
+	while (true){
+		PackedByteArray chunk = file->get_buffer(FINGERPRINT_CHUNK_SIZE);
+		if (chunk.is_empty()){
+			break;
+		}
+
+		hash_low = hash_murmur3_buffer(chunk.ptr(), chunk.size(), hash_low);
+		hash_high = hash_murmur3_buffer(chunk.ptr(), chunk.size(), hash_high);
+	}
+
+	uint64_t hash = ((uint64_t)hash_high << 32) | hash_low;
+	return String::num_int64(file->get_length()) + "-" + String::num_uint64(hash, 16);
+}
+
 // Print all indexed assets and their paths.
 void DynamicAssetIndexer::dump_asset_map() {
 	index_files();
@@ -0,0 +1,175 @@
+#include "dynamic_content_loader.hpp"
+#include "asset_logger.hpp"
+
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+// Expose DynamicContentLoader methods to Godot.
+void DynamicContentLoader::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_loader_name"), &DynamicContentLoader::get_loader_name);
+	ClassDB::bind_method(D_METHOD("get_resource_type"), &DynamicContentLoader::get_resource_type);
+	ClassDB::bind_method(D_METHOD("get_recognized_extensions"), &DynamicContentLoader::get_recognized_extensions);
+
+	ClassDB::bind_method(D_METHOD("is_thread_safe"), &DynamicContentLoader::is_thread_safe);
+	ClassDB::bind_method(D_METHOD("get_preferred_thread"), &DynamicContentLoader::get_preferred_thread);
+	ClassDB::bind_method(D_METHOD("get_cache_policy"), &DynamicContentLoader::get_cache_policy);
+
+	ClassDB::bind_method(D_METHOD("recognizes_path", "path"), &DynamicContentLoader::recognizes_path);
+	ClassDB::bind_method(D_METHOD("decode_from_path", "path"), &DynamicContentLoader::decode_from_path);
+	ClassDB::bind_method(D_METHOD("finalize_resource", "decoded", "path"), &DynamicContentLoader::finalize_resource);
+	ClassDB::bind_method(D_METHOD("load_from_path", "path"), &DynamicContentLoader::load_from_path);
+	ClassDB::bind_method(D_METHOD("get_dependencies", "path"), &DynamicContentLoader::get_dependencies);
+	ClassDB::bind_method(D_METHOD("estimate_resource_size", "resource", "path"), &DynamicContentLoader::estimate_resource_size);
+
+	GDVIRTUAL_BIND(_get_loader_name);
+	GDVIRTUAL_BIND(_get_resource_type);
+	GDVIRTUAL_BIND(_get_recognized_extensions);
+	GDVIRTUAL_BIND(_is_thread_safe);
+	GDVIRTUAL_BIND(_get_preferred_thread);
+	GDVIRTUAL_BIND(_get_cache_policy);
+	GDVIRTUAL_BIND(_decode_from_path, "path");
+	GDVIRTUAL_BIND(_finalize_resource, "decoded", "path");
+	GDVIRTUAL_BIND(_get_dependencies, "path");
+	GDVIRTUAL_BIND(_estimate_resource_size, "resource", "path");
+
+	BIND_ENUM_CONSTANT(LOAD_THREAD_ANY);
+	BIND_ENUM_CONSTANT(LOAD_THREAD_WORKER);
+	BIND_ENUM_CONSTANT(LOAD_THREAD_CALLER);
+
+	BIND_ENUM_CONSTANT(CACHE_POLICY_NONE);
+	BIND_ENUM_CONSTANT(CACHE_POLICY_SHARED);
+	BIND_ENUM_CONSTANT(CACHE_POLICY_PERSISTENT);
+}
+
+DynamicContentLoader::DynamicContentLoader() {}
+
+DynamicContentLoader::~DynamicContentLoader() {}
+
+String DynamicContentLoader::get_loader_name() const {
+	String name;
+	if (GDVIRTUAL_CALL(_get_loader_name, name)){
+		return name;
+	}
+
+	return get_class();
+}
+
+String DynamicContentLoader::get_resource_type() const {
+	String type;
+	if (GDVIRTUAL_CALL(_get_resource_type, type)){
+		return type;
+	}
+
+	return "Resource";
+}
+
+// Empty list means the loader accepts any file of its content type.
+PackedStringArray DynamicContentLoader::get_recognized_extensions() const {
+	PackedStringArray extensions;
+	if (GDVIRTUAL_CALL(_get_recognized_extensions, extensions)){
+		return extensions;
+	}
+
+	return PackedStringArray();
+}
+
+bool DynamicContentLoader::is_thread_safe() const {
+	bool thread_safe = false;
+	if (GDVIRTUAL_CALL(_is_thread_safe, thread_safe)){
+		return thread_safe;
+	}
+
+	return false;
+}
+
+// Scheduling hint for callers; the prefix handler decodes on whichever thread requested the load.
+DynamicContentLoader::LoadThread DynamicContentLoader::get_preferred_thread() const {
+	int thread = LOAD_THREAD_CALLER;
+	if (GDVIRTUAL_CALL(_get_preferred_thread, thread)){
+		return LoadThread(thread);
+	}
+
+	return LOAD_THREAD_CALLER;
+}
+
+DynamicContentLoader::CachePolicy DynamicContentLoader::get_cache_policy() const {
+	int policy = CACHE_POLICY_NONE;
+	if (GDVIRTUAL_CALL(_get_cache_policy, policy)){
+		return CachePolicy(policy);
+	}
+
+	return CACHE_POLICY_NONE;
+}
+
+// Check the file extension against the recognized extensions.
+bool DynamicContentLoader::recognizes_path(const String &p_path) const {
+	PackedStringArray extensions = get_recognized_extensions();
+	if (extensions.is_empty()){
+		return true;
+	}
+
+	String extension = p_path.get_extension().to_lower();
+	return extensions.has(extension);
+}
+
+// Read and decode an already resolved file; may run on a worker thread.
+Variant DynamicContentLoader::decode_from_path(const String &p_path) const {
+	Variant decoded;
+	if (GDVIRTUAL_CALL(_decode_from_path, p_path, decoded)){
+		return decoded;
+	}
+
+	EAM_LOG_ERROR("No load implementation in " + get_loader_name() + " for: '" + p_path + "'");
+	return FAILED;
+}
+
+// Turn decoded data into the final resource on the thread that requested the load.
+Variant DynamicContentLoader::finalize_resource(const Variant &p_decoded, const String &p_path) const {
+	Variant resource;
+	if (GDVIRTUAL_CALL(_finalize_resource, p_decoded, p_path, resource)){
+		return resource;
+	}
+
+	return p_decoded;
+}
+
+// Decode and finalize on the calling thread.
+Variant DynamicContentLoader::load_from_path(const String &p_path) const {
+	Variant decoded = decode_from_path(p_path);
+	if (decoded.get_type() != Variant::OBJECT){
+		return decoded;
+	}
+
+	return finalize_resource(decoded, p_path);
+}
+
+// Resource paths the file loads along with it, as dyn:// or res:// paths.
+PackedStringArray DynamicContentLoader::get_dependencies(const String &p_path) const {
+	PackedStringArray dependencies;
+	if (GDVIRTUAL_CALL(_get_dependencies, p_path, dependencies)){
+		return dependencies;
+	}
+
+	return PackedStringArray();
+}
+
+// Block until work the loader started in the background has finished; nothing by default.
+void DynamicContentLoader::wait_for_background_tasks(){
+}
+
+// Approximate memory held by a loaded resource; defaults to its file size.
+int64_t DynamicContentLoader::estimate_resource_size(const Variant &p_resource, const String &p_path) const {
+	int64_t size = 0;
+	if (GDVIRTUAL_CALL(_estimate_resource_size, p_resource, p_path, size)){
+		return size;
+	}
+
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
+	if (file.is_null()){
+		return 0;
+	}
+
+	return file->get_length();
+}
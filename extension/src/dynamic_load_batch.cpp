@@ -0,0 +1,102 @@
+#include "dynamic_load_batch.hpp"
+#include "asset_logger.hpp"
+
+#include "dynmaic_prefix_handler.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+
+using namespace godot;
+
+void DynamicLoadBatch::_bind_methods() {}
+
+DynamicLoadBatch::DynamicLoadBatch():wait_mutex{memnew(godot::Mutex)} {}
+
+DynamicLoadBatch::~DynamicLoadBatch() {}
+
+// Queue one pool element per resource path.
+void DynamicLoadBatch::start(DynmaicPrefixHandler *p_handler, int64_t p_batch_id, const PackedStringArray &p_paths, bool p_high_priority){
+	handler = p_handler;
+	batch_id = p_batch_id;
+	resource_paths = p_paths;
+	loaded_resources.resize(p_paths.size());
+
+	if (p_paths.is_empty()){
+		MutexLock lock{**wait_mutex};
+		task_waited = true;
+		handler->call_deferred("emit_signal", "batch_completed", batch_id, 0);
+		return;
+	}
+
+	group_task_id = WorkerThreadPool::get_singleton()->add_group_task(
+		callable_mp(this, &DynamicLoadBatch::load_element),
+		p_paths.size(),
+		-1,
+		p_high_priority,
+		"Dynamic preload batch " + String::num_int64(batch_id)
+	);
+}
+
+// Load one resource on a pool thread and report progress.
+void DynamicLoadBatch::load_element(uint32_t p_index){
+	String resource_path = resource_paths[p_index];
+	Variant load_result = handler->load_dynamic_resource(resource_path, false, ResourceLoader::CACHE_MODE_REUSE);
+
+	if (load_result.get_type() == Variant::OBJECT){
+		loaded_resources[p_index] = load_result;
+	}else{
+		EAM_LOG_WARNING("Failed to preload dynamic resource: '" + resource_path + "'");
+		failed_count++;
+	}
+
+	uint32_t total = resource_paths.size();
+	uint32_t processed = ++processed_count;
+
+	handler->call_deferred("emit_signal", "batch_progress", batch_id, processed, total);
+	if (processed == total){
+		// Release the pool task even if the batch is only polled and never waited for or released.
+		handler->call_deferred("_finish_batch_task", batch_id);
+		handler->call_deferred("emit_signal", "batch_completed", batch_id, failed_count.load());
+	}
+}
+
+// Block until every element finished and release the pool task.
+void DynamicLoadBatch::wait(){
+	MutexLock lock{**wait_mutex};
+	if (task_waited){
+		return;
+	}
+
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task_id);
+	task_waited = true;
+}
+
+bool DynamicLoadBatch::is_completed() const{
+	return processed_count.load() == (uint32_t)resource_paths.size();
+}
+
+float DynamicLoadBatch::get_progress() const{
+	if (resource_paths.is_empty()){
+		return 1.0;
+	}
+
+	return (float)processed_count.load() / (float)resource_paths.size();
+}
+
+int64_t DynamicLoadBatch::get_failed_count() const{
+	return failed_count.load();
+}
+
+// Return loaded resources in request order; failed entries are null.
+Array DynamicLoadBatch::get_resources() const{
+	Array resources;
+	if (!is_completed()){
+		return resources;
+	}
+
+	for (uint32_t i = 0; i < loaded_resources.size(); i++){
+		resources.append(loaded_resources[i]);
+	}
+	return resources;
+}
@@ -0,0 +1,94 @@
+#include "dynamic_resource_cache.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+// Dead entries are swept after this many inserts.
+static constexpr uint32_t PRUNE_INTERVAL = 64;
+
+void DynamicResourceCache::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("clear"), &DynamicResourceCache::clear);
+	ClassDB::bind_method(D_METHOD("get_entry_count"), &DynamicResourceCache::get_entry_count);
+}
+
+DynamicResourceCache::DynamicResourceCache():cache_mutex{memnew(godot::Mutex)} {}
+
+DynamicResourceCache::~DynamicResourceCache() {}
+
+// Return the live resource for a key, dropping the entry if it died or went stale.
+Ref<Resource> DynamicResourceCache::get_resource(String resource_key, uint64_t generation){
+	MutexLock lock{**cache_mutex};
+
+	auto entry = entries.find(resource_key);
+	if (entry == entries.end()){
+		return nullptr;
+	}
+
+	Ref<Resource> resource{};
+	if (entry->value.generation == generation){
+		resource = entry->value.resource_ref->get_ref();
+	}
+
+	if (resource.is_null()){
+		entries.erase(resource_key);
+	}
+
+	return resource;
+}
+
+// Remember a resource without keeping it alive.
+void DynamicResourceCache::store_resource(String resource_key, uint64_t generation, Ref<Resource> resource){
+	if (resource.is_null()){
+		return;
+	}
+
+	Ref<WeakRef> resource_ref = UtilityFunctions::weakref(resource);
+	if (resource_ref.is_null()){
+		return;
+	}
+
+	MutexLock lock{**cache_mutex};
+
+	CacheEntry entry{};
+	entry.resource_ref = resource_ref;
+	entry.generation = generation;
+	entries[resource_key] = entry;
+
+	if (++inserts_since_prune >= PRUNE_INTERVAL){
+		_prune_dead_entries();
+	}
+}
+
+void DynamicResourceCache::remove_resource(String resource_key){
+	MutexLock lock{**cache_mutex};
+	entries.erase(resource_key);
+}
+
+void DynamicResourceCache::clear(){
+	MutexLock lock{**cache_mutex};
+	entries.clear();
+	inserts_since_prune = 0;
+}
+
+int64_t DynamicResourceCache::get_entry_count(){
+	MutexLock lock{**cache_mutex};
+	_prune_dead_entries();
+	return entries.size();
+}
+
+// Drop entries whose resource has been freed. Caller must hold cache_mutex.
+void DynamicResourceCache::_prune_dead_entries(){
+	inserts_since_prune = 0;
+
+	Vector<String> dead_keys;
+	for (const auto &[key, entry] : entries){
+		if (entry.resource_ref->get_ref().get_type() == Variant::NIL){
+			dead_keys.push_back(key);
+		}
+	}
+
+	for (const String &key : dead_keys){
+		entries.erase(key);
+	}
+}
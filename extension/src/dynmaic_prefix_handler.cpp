@@ -1,14 +1,15 @@
 #include "dynmaic_prefix_handler.hpp"
+#include "asset_logger.hpp"
 
 #include "dynamic_asset_indexer.hpp"
+#include "content_loader_registry.hpp"
 #include "identifier.hpp"
 
+#include "godot_cpp/classes/class_db_singleton.hpp"
+#include "godot_cpp/classes/os.hpp"
+#include "godot_cpp/classes/performance.hpp"
 #include "godot_cpp/classes/resource_loader.hpp"
-#include "godot_cpp/classes/image.hpp"
-#include "godot_cpp/classes/image_texture.hpp"
-#include "godot_cpp/classes/font_file.hpp"
-#include "godot_cpp/classes/file_access.hpp"
-#include "godot_cpp/classes/json.hpp"
+#include "godot_cpp/classes/time.hpp"
 
 using namespace godot;
 
@@ -17,23 +18,40 @@ void DynmaicPrefixHandler::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load_texture_from_path"), &DynmaicPrefixHandler::load_texture_from_path);
 	ClassDB::bind_method(D_METHOD("load_font_from_path"), &DynmaicPrefixHandler::load_font_from_path);
 	ClassDB::bind_method(D_METHOD("load_json_from_path"), &DynmaicPrefixHandler::load_json_from_path);
+
+	ClassDB::bind_method(D_METHOD("preload_batch", "resource_paths", "high_priority"), &DynmaicPrefixHandler::preload_batch, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_batch_progress", "batch_id"), &DynmaicPrefixHandler::get_batch_progress);
+	ClassDB::bind_method(D_METHOD("is_batch_completed", "batch_id"), &DynmaicPrefixHandler::is_batch_completed);
+	ClassDB::bind_method(D_METHOD("wait_for_batch", "batch_id"), &DynmaicPrefixHandler::wait_for_batch);
+	ClassDB::bind_method(D_METHOD("get_batch_resources", "batch_id"), &DynmaicPrefixHandler::get_batch_resources);
+	ClassDB::bind_method(D_METHOD("release_batch", "batch_id"), &DynmaicPrefixHandler::release_batch);
+	ClassDB::bind_method(D_METHOD("_finish_batch_task", "batch_id"), &DynmaicPrefixHandler::_finish_batch_task);
+
+	ClassDB::bind_method(D_METHOD("set_content_deduplication", "enabled"), &DynmaicPrefixHandler::set_content_deduplication);
+	ClassDB::bind_method(D_METHOD("get_content_deduplication"), &DynmaicPrefixHandler::get_content_deduplication);
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "content_deduplication"), "set_content_deduplication", "get_content_deduplication");
+
+	ClassDB::bind_method(D_METHOD("get_load_latency_stats"), &DynmaicPrefixHandler::get_load_latency_stats);
+	ClassDB::bind_method(D_METHOD("reset_load_latency_stats"), &DynmaicPrefixHandler::reset_load_latency_stats);
+	ClassDB::bind_method(D_METHOD("_register_latency_monitors", "content_type"), &DynmaicPrefixHandler::_register_latency_monitors);
+
+	ClassDB::bind_method(D_METHOD("set_residency_budget", "content_type", "budget_bytes"), &DynmaicPrefixHandler::set_residency_budget);
+	ClassDB::bind_method(D_METHOD("get_residency_budget", "content_type"), &DynmaicPrefixHandler::get_residency_budget);
+	ClassDB::bind_method(D_METHOD("get_residency_stats"), &DynmaicPrefixHandler::get_residency_stats);
+	ClassDB::bind_method(D_METHOD("trim_residency"), &DynmaicPrefixHandler::trim_residency);
+	ClassDB::bind_method(D_METHOD("touch_resource", "resource_path"), &DynmaicPrefixHandler::touch_resource);
+
+	ADD_SIGNAL(MethodInfo("batch_progress", PropertyInfo(Variant::INT, "batch_id"), PropertyInfo(Variant::INT, "loaded"), PropertyInfo(Variant::INT, "total")));
+	ADD_SIGNAL(MethodInfo("batch_completed", PropertyInfo(Variant::INT, "batch_id"), PropertyInfo(Variant::INT, "failed")));
 }
 
-DynmaicPrefixHandler::DynmaicPrefixHandler() {}
+DynmaicPrefixHandler::DynmaicPrefixHandler():unsafe_load_mutex{memnew(godot::Mutex)}, resource_cache{memnew(DynamicResourceCache)}, residency_manager{memnew(ResourceResidencyManager)}, latency_stats{memnew(LoadLatencyStats)}, batch_mutex{memnew(godot::Mutex)} {}
 
 Ref<DynmaicPrefixHandler> DynmaicPrefixHandler::_DynmaicPrefixHandlerSingleton{};
 
 // Check if path matches supported content type prefixes.
 bool DynmaicPrefixHandler::_recognize_path(const String &p_path, const StringName &p_type) const {
-	static TypedArray<String> supported_prefixes = Identifier::get_all_content_types();
-    for (int64_t i = 0; i < supported_prefixes.size(); i++){
-		String prefix = supported_prefixes[i];
-        if (p_path.begins_with(prefix + "://")){
-            return true;
-        }
-    }
-    
-	return false;
+	return Identifier::get_content_type_from_resouce(p_path) != "";
 }
 
 // Handle dependency renames (no-op for now).
@@ -41,94 +59,487 @@ Error DynmaicPrefixHandler::_rename_dependencies(const String &p_path, const Dic
     return OK;
 }
 
+// Report what a dynamic resource depends on, so the threaded loader can load dependencies in parallel.
+// Imported files report their own dependencies; native files ask their content loader.
+PackedStringArray DynmaicPrefixHandler::_get_dependencies(const String &p_path, bool p_add_types) const{
+	Ref<Identifier> resource_id{};
+	String fixed_path = "";
+	if (!resolve_dynamic_path(p_path, resource_id, fixed_path)){
+		return PackedStringArray();
+	}
+
+	if (ResourceLoader::get_singleton()->exists(fixed_path)){
+		PackedStringArray dependencies = ResourceLoader::get_singleton()->get_dependencies(fixed_path);
+		if (p_add_types){
+			return dependencies;
+		}
+
+		// Entries are "uid::type::path" when types are included.
+		PackedStringArray dependency_paths;
+		for (int64_t i = 0; i < dependencies.size(); i++){
+			String dependency = dependencies[i];
+			dependency_paths.push_back(dependency.get_slice("::", dependency.get_slice_count("::") - 1));
+		}
+		return dependency_paths;
+	}
+
+	Ref<DynamicContentLoader> loader = ContentLoaderRegistry::get_singleton()->get_loader(resource_id->get_content_type(), fixed_path);
+	if (loader.is_null()){
+		return PackedStringArray();
+	}
+
+	return loader->get_dependencies(fixed_path);
+}
+
+// Resource class a dynamic path loads as, taken from its content loader.
+// Files Godot imported may load as any resource type, so they only report "Resource".
+String DynmaicPrefixHandler::_get_resource_type(const String &p_path) const{
+	Ref<Identifier> resource_id{};
+	String fixed_path = "";
+	if (!resolve_dynamic_path(p_path, resource_id, fixed_path)){
+		return "";
+	}
+
+	if (ResourceLoader::get_singleton()->exists(fixed_path)){
+		return "Resource";
+	}
+
+	Ref<DynamicContentLoader> loader = ContentLoaderRegistry::get_singleton()->get_loader(resource_id->get_content_type(), fixed_path);
+	if (loader.is_null()){
+		return "";
+	}
+
+	return loader->get_resource_type();
+}
+
+// Check if any registered content loader produces the type or one of its subclasses.
+bool DynmaicPrefixHandler::_handles_type(const StringName &p_type) const{
+	if (p_type == StringName("Resource")){
+		return true;
+	}
+
+	ClassDBSingleton *class_db = ClassDBSingleton::get_singleton();
+	TypedArray<DynamicContentLoader> loaders = ContentLoaderRegistry::get_singleton()->get_all_loaders();
+	for (int64_t i = 0; i < loaders.size(); i++){
+		Ref<DynamicContentLoader> loader = loaders[i];
+		if (loader.is_valid() && class_db->is_parent_class(loader->get_resource_type(), p_type)){
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Map a dynamic path to its identifier and indexed file; false when it is not indexed.
+bool DynmaicPrefixHandler::resolve_dynamic_path(const String &p_path, Ref<Identifier> &r_resource_id, String &r_fixed_path) const{
+	r_resource_id = Identifier::for_resource(p_path);
+	if (r_resource_id == nullptr || !r_resource_id->is_valid()){
+		return false;
+	}
+
+	r_fixed_path = DynamicAssetIndexer::get_singleton()->get_asset_path(r_resource_id);
+	return r_fixed_path != "";
+}
+
 // Load resource using asset indexer and loaders.
 Variant DynmaicPrefixHandler::_load(const String &p_path, const String &p_original_path, bool p_use_sub_threads, int32_t p_cache_mode) const{
-    TypedArray<String> resource_stuff = DynamicAssetIndexer::get_singleton()->get_resource_path(p_path);
-	if (resource_stuff.size() < 2){
-		UtilityFunctions::print("Failed to get resource path for: '" + p_path + "'");
+	return load_dynamic_resource(p_path, p_use_sub_threads, p_cache_mode);
+}
+
+// Resolve a dynamic path and load it; shared by _load and preload batches.
+// Time spent in each stage is recorded per content type.
+Variant DynmaicPrefixHandler::load_dynamic_resource(const String &p_path, bool p_use_sub_threads, int32_t p_cache_mode) const{
+	Time *time = Time::get_singleton();
+	uint64_t load_start = time->get_ticks_usec();
+	uint64_t generation = DynamicAssetIndexer::get_singleton()->get_index_generation();
+
+	Ref<Identifier> resource_id{};
+	String fixed_path = "";
+	if (!resolve_dynamic_path(p_path, resource_id, fixed_path)){
+		EAM_LOG_ERROR("Failed to get resource path for: '" + p_path + "'");
 		return FAILED;
-    }
+	}
+
+	String content_type = resource_id->get_content_type();
+	record_latency(content_type, LoadLatencyStats::STAGE_RESOLVE, time->get_ticks_usec() - load_start);
+
+	Variant load_result = load_resolved_resource(resource_id, fixed_path, generation, p_use_sub_threads, p_cache_mode);
+
+	record_latency(content_type, LoadLatencyStats::STAGE_TOTAL, time->get_ticks_usec() - load_start);
+	return load_result;
+}
+
+// Load an indexed file through the ResourceLoader or its content loader, sharing cached instances.
+// One instance is shared per identifier (and per content fingerprint with deduplication), so every
+// alias of an asset resolves to the same object. Godot moves a resource's path to whichever alias
+// it was last returned for, so alternating aliases miss the engine's ResourceCache and come back
+// through _load, where they are answered from this cache without decoding again.
+Variant DynmaicPrefixHandler::load_resolved_resource(const Ref<Identifier> &resource_id, const String &fixed_path, uint64_t generation, bool p_use_sub_threads, int32_t p_cache_mode) const{
+	auto indexer = DynamicAssetIndexer::get_singleton();
+
+	Time *time = Time::get_singleton();
+	String content_type = resource_id->get_content_type();
 
-	String fixed_path = resource_stuff[0];
-    String content_type = resource_stuff[1];
-	
     if (ResourceLoader::get_singleton()->exists(fixed_path)){
-		UtilityFunctions::print("loading '"+ fixed_path + "' from the ResourceLoader.");
-		auto load_result = ResourceLoader::get_singleton()->load(fixed_path);
-		if (load_result != nullptr && load_result.is_valid()){
-			return load_result;
-        }else{
-			UtilityFunctions::print("Failed to load resource from ResourceLoader: '" + fixed_path + "'");
-			return FAILED;
-        }
+		uint64_t imported_start = time->get_ticks_usec();
+		Variant imported_result = load_imported_resource(fixed_path, p_use_sub_threads, p_cache_mode);
+		record_latency(content_type, LoadLatencyStats::STAGE_IMPORTED, time->get_ticks_usec() - imported_start);
+		return imported_result;
     }
 
-	UtilityFunctions::print("loading '" + p_path + "' as: " + fixed_path);
-    if (content_type == "textures"){
-        return load_texture_from_path(fixed_path);
-    }else if (content_type == "fonts"){
-        return load_font_from_path(fixed_path);
-    }else{
-        if (fixed_path.ends_with(".json")){
-            return load_json_from_path(fixed_path);
-        }
-    }
+	EAM_LOG_DEBUG("loading '" + resource_id->to_string() + "' as: " + fixed_path);
+	Ref<DynamicContentLoader> loader = ContentLoaderRegistry::get_singleton()->get_loader(content_type, fixed_path);
+	if (loader.is_null()){
+		EAM_LOG_ERROR("No content loader registered for '" + content_type + "': '" + fixed_path + "'");
+		return FAILED;
+	}
+
+	bool use_identity_cache = loader->get_cache_policy() != DynamicContentLoader::CACHE_POLICY_NONE;
+	bool reuse_cached = p_cache_mode == ResourceLoader::CACHE_MODE_REUSE;
+	bool store_cached = reuse_cached || p_cache_mode == ResourceLoader::CACHE_MODE_REPLACE || p_cache_mode == ResourceLoader::CACHE_MODE_REPLACE_DEEP;
+
+	uint64_t cache_start = time->get_ticks_usec();
 
-    return FAILED;
+	String resource_key = resource_id->to_string();
+	if (use_identity_cache && reuse_cached){
+		Ref<Resource> cached_resource = resource_cache->get_resource(resource_key, generation);
+		if (cached_resource.is_valid()){
+			residency_manager->touch_resource(cached_resource);
+			record_latency(content_type, LoadLatencyStats::STAGE_CACHE, time->get_ticks_usec() - cache_start);
+			return cached_resource;
+		}
+	}
+
+	// Identical files under other identifiers share the instance loaded for the first one.
+	String content_key = "";
+	if (use_identity_cache && content_deduplication){
+		String fingerprint = indexer->get_content_fingerprint(fixed_path);
+		if (fingerprint != ""){
+			content_key = "content:" + loader->get_loader_name() + ":" + fingerprint;
+		}
+	}
+
+	if (content_key != "" && reuse_cached){
+		Ref<Resource> shared_resource = resource_cache->get_resource(content_key, generation);
+		if (shared_resource.is_valid()){
+			resource_cache->store_resource(resource_key, generation, shared_resource);
+			residency_manager->touch_resource(shared_resource);
+			record_latency(content_type, LoadLatencyStats::STAGE_CACHE, time->get_ticks_usec() - cache_start);
+			return shared_resource;
+		}
+	}
+
+	record_latency(content_type, LoadLatencyStats::STAGE_CACHE, time->get_ticks_usec() - cache_start);
+
+	Variant load_result = run_content_loader(loader, fixed_path, content_type);
+	if (use_identity_cache && store_cached && load_result.get_type() == Variant::OBJECT){
+		resource_cache->store_resource(resource_key, generation, load_result);
+		if (content_key != ""){
+			resource_cache->store_resource(content_key, generation, load_result);
+		}
+
+		if (residency_manager->has_budget(content_type)){
+			int64_t size_bytes = loader->estimate_resource_size(load_result, fixed_path);
+			residency_manager->track_resource(content_type, load_result, size_bytes);
+		}
+	}
+
+	return load_result;
 }
 
+// Load a file Godot already imported, forwarding the caller's cache mode.
+// Sub-thread loads go through the threaded loader so dependencies load in parallel.
+Variant DynmaicPrefixHandler::load_imported_resource(const String &fixed_path, bool p_use_sub_threads, int32_t p_cache_mode) const{
+	EAM_LOG_DEBUG("loading '"+ fixed_path + "' from the ResourceLoader.");
 
-// Load image file and create texture resource.
-Variant DynmaicPrefixHandler::load_texture_from_path(String fixed_path) const{
-	auto loaded_image = Image::load_from_file(fixed_path);
-	if (loaded_image.is_null()){
-		UtilityFunctions::print("Error loading image from file.");
+	ResourceLoader *resource_loader = ResourceLoader::get_singleton();
+	auto cache_mode = static_cast<ResourceLoader::CacheMode>(p_cache_mode);
+
+	Ref<Resource> load_result{};
+	if (p_use_sub_threads){
+		Error err = resource_loader->load_threaded_request(fixed_path, "", true, cache_mode);
+		if (err == OK){
+			load_result = resource_loader->load_threaded_get(fixed_path);
+		}
+	}else{
+		load_result = resource_loader->load(fixed_path, "", cache_mode);
+	}
+
+	if (load_result == nullptr || !load_result.is_valid()){
+		EAM_LOG_ERROR("Failed to load resource from ResourceLoader: '" + fixed_path + "'");
 		return FAILED;
-    }
-	
-	auto loaded_texture = ImageTexture::create_from_image(loaded_image);
-	if (loaded_texture.is_null()){
-		UtilityFunctions::print("error loading dynamic texture: '" + fixed_path + "'");
+	}
+
+	return load_result;
+}
+
+// Run a content loader on the thread that requested the load.
+// Handing the decode to a pool task and blocking on it adds a context switch without any overlap,
+// so loads run in parallel through the engine's threaded loader and preload batches instead.
+Variant DynmaicPrefixHandler::run_content_loader(const Ref<DynamicContentLoader> &loader, const String &fixed_path, const String &content_type) const{
+	if (!loader->is_thread_safe()){
+		MutexLock lock{**unsafe_load_mutex};
+		return decode_and_finalize(loader, fixed_path, content_type);
+	}
+
+	return decode_and_finalize(loader, fixed_path, content_type);
+}
+
+Variant DynmaicPrefixHandler::decode_and_finalize(const Ref<DynamicContentLoader> &loader, const String &fixed_path, const String &content_type) const{
+	Time *time = Time::get_singleton();
+	uint64_t decode_start = time->get_ticks_usec();
+
+	Variant decoded = loader->decode_from_path(fixed_path);
+
+	uint64_t decode_end = time->get_ticks_usec();
+	record_latency(content_type, LoadLatencyStats::STAGE_DECODE, decode_end - decode_start);
+	EAM_LOG_TRACE("decoded '" + fixed_path + "' on thread ", OS::get_singleton()->get_thread_caller_id(), " in ", decode_end - decode_start, " usec");
+
+	if (decoded.get_type() != Variant::OBJECT){
+		return decoded;
+	}
+
+	Variant load_result = loader->finalize_resource(decoded, fixed_path);
+	record_latency(content_type, LoadLatencyStats::STAGE_FINALIZE, time->get_ticks_usec() - decode_end);
+	return load_result;
+}
+
+// Load a file directly with a registered loader, bypassing the index and caches.
+Variant DynmaicPrefixHandler::load_with_named_loader(const String &loader_name, const String &fixed_path) const{
+	Ref<DynamicContentLoader> loader = ContentLoaderRegistry::get_singleton()->get_loader_by_name(loader_name);
+	if (loader.is_null()){
+		EAM_LOG_ERROR("No content loader named '" + loader_name + "' for: '" + fixed_path + "'");
 		return FAILED;
-    }
-	
-	return loaded_texture;
+	}
+
+	if (!loader->is_thread_safe()){
+		MutexLock lock{**unsafe_load_mutex};
+		return loader->load_from_path(fixed_path);
+	}
+
+	return loader->load_from_path(fixed_path);
+}
+
+// Deprecated: load an image file as a texture through the textures loader.
+Variant DynmaicPrefixHandler::load_texture_from_path(String fixed_path) const{
+	return load_with_named_loader("textures", fixed_path);
 }
 
-// Load font file and create font resource.
+// Deprecated: load a font file through the fonts loader.
 Variant DynmaicPrefixHandler::load_font_from_path(String fixed_path) const{
-	Ref<FontFile> loaded_font{};
-	loaded_font.instantiate();
+	return load_with_named_loader("fonts", fixed_path);
+}
 
-	auto err = loaded_font->load_dynamic_font(fixed_path);
+// Deprecated: load a JSON file through the json loader.
+Variant DynmaicPrefixHandler::load_json_from_path(String fixed_path) const{
+	return load_with_named_loader("json", fixed_path);
+}
 
-	if (err != OK){
-		UtilityFunctions::print("error loading dynamic font: '" + fixed_path + "'");
-        return FAILED;
-    }
-	
-	return loaded_font;
+// Add a stage sample; monitors for a new content type are registered on the main thread.
+void DynmaicPrefixHandler::record_latency(const String &content_type, LoadLatencyStats::Stage stage, uint64_t elapsed_usec) const{
+	if (latency_stats->record(content_type, stage, elapsed_usec)){
+		const_cast<DynmaicPrefixHandler *>(this)->call_deferred("_register_latency_monitors", content_type);
+	}
 }
 
+// Show average and 95th percentile load times of a content type in the debugger monitors.
+void DynmaicPrefixHandler::_register_latency_monitors(String content_type){
+	Performance *performance = Performance::get_singleton();
 
-// Load JSON file and create JSON resource.
-Variant DynmaicPrefixHandler::load_json_from_path(String fixed_path) const{
-	auto file = FileAccess::open(fixed_path, FileAccess::ModeFlags::READ);
-	if (file == nullptr || file.is_null()){
-		UtilityFunctions::print("error dynamic json not in file loader: '" + fixed_path + "'");
-		return FAILED;
-    }
+	struct MonitorSpec {
+		const char *name;
+		LoadLatencyStats::Stage stage;
+		double percentile;
+	};
+	const MonitorSpec monitor_specs[] = {
+		{ "total_avg_ms", LoadLatencyStats::STAGE_TOTAL, 0.0 },
+		{ "total_p95_ms", LoadLatencyStats::STAGE_TOTAL, 0.95 },
+		{ "decode_avg_ms", LoadLatencyStats::STAGE_DECODE, 0.0 },
+	};
+
+	for (const MonitorSpec &spec : monitor_specs){
+		StringName monitor_id = "DynamicLoader/" + content_type + "_" + spec.name;
+		if (performance->has_custom_monitor(monitor_id)){
+			continue;
+		}
 
-	Ref<JSON> json_data{};
-	json_data.instantiate();
+		performance->add_custom_monitor(monitor_id, callable_mp(this, &DynmaicPrefixHandler::get_latency_monitor_value).bind(content_type, (int32_t)spec.stage, spec.percentile));
+		latency_monitor_ids.push_back(monitor_id);
+	}
+}
 
-	auto error = json_data->parse(file->get_as_text());
-	file->close();
+double DynmaicPrefixHandler::get_latency_monitor_value(String content_type, int32_t stage, double percentile){
+	return latency_stats->get_monitor_value(content_type, (LoadLatencyStats::Stage)stage, percentile);
+}
 
-	if (error != OK){
-		UtilityFunctions::print("error parsing dynamic json: '" + fixed_path + "'");
-		return FAILED;
-    }
+// Load time histograms per content type and stage: resolve, cache, imported, decode, finalize and total.
+Dictionary DynmaicPrefixHandler::get_load_latency_stats(){
+	return latency_stats->get_stats();
+}
+
+void DynmaicPrefixHandler::reset_load_latency_stats(){
+	latency_stats->reset();
+}
+
+// Remove the debugger monitors; called before the handler is unregistered.
+void DynmaicPrefixHandler::release_latency_monitors(){
+	Performance *performance = Performance::get_singleton();
+	for (const StringName &monitor_id : latency_monitor_ids){
+		if (performance->has_custom_monitor(monitor_id)){
+			performance->remove_custom_monitor(monitor_id);
+		}
+	}
+	latency_monitor_ids.clear();
+}
+
+// Start loading many dynamic resources concurrently; returns the batch id.
+// Results land in the identity cache and stay alive until the batch is released.
+int64_t DynmaicPrefixHandler::preload_batch(PackedStringArray resource_paths, bool high_priority){
+	Ref<DynamicLoadBatch> batch{};
+	batch.instantiate();
+
+	int64_t batch_id = 0;
+	{
+		MutexLock lock{**batch_mutex};
+		batch_id = next_batch_id++;
+		load_batches[batch_id] = batch;
+	}
+
+	batch->start(this, batch_id, resource_paths, high_priority);
+	return batch_id;
+}
+
+Ref<DynamicLoadBatch> DynmaicPrefixHandler::get_batch(int64_t batch_id){
+	MutexLock lock{**batch_mutex};
+	if (!load_batches.has(batch_id)){
+		return nullptr;
+	}
+
+	return load_batches[batch_id];
+}
+
+// Fraction of the batch that finished loading, from 0 to 1.
+float DynmaicPrefixHandler::get_batch_progress(int64_t batch_id){
+	auto batch = get_batch(batch_id);
+	if (batch.is_null()){
+		return 0.0;
+	}
+
+	return batch->get_progress();
+}
+
+bool DynmaicPrefixHandler::is_batch_completed(int64_t batch_id){
+	auto batch = get_batch(batch_id);
+	if (batch.is_null()){
+		return false;
+	}
+
+	return batch->is_completed();
+}
+
+// Block until the batch finished and return its resources.
+Array DynmaicPrefixHandler::wait_for_batch(int64_t batch_id){
+	auto batch = get_batch(batch_id);
+	if (batch.is_null()){
+		EAM_LOG_WARNING("Unknown preload batch: ", batch_id);
+		return Array();
+	}
+
+	batch->wait();
+	return batch->get_resources();
+}
+
+// Return the batch resources in request order, or an empty array while loading.
+Array DynmaicPrefixHandler::get_batch_resources(int64_t batch_id){
+	auto batch = get_batch(batch_id);
+	if (batch.is_null()){
+		return Array();
+	}
+
+	return batch->get_resources();
+}
+
+// Drop the batch and its references once loading finished.
+void DynmaicPrefixHandler::release_batch(int64_t batch_id){
+	auto batch = get_batch(batch_id);
+	if (batch.is_null()){
+		return;
+	}
+
+	batch->wait();
+
+	MutexLock lock{**batch_mutex};
+	load_batches.erase(batch_id);
+}
+
+// Release the pool task of a batch whose last element finished; deferred from the pool thread.
+void DynmaicPrefixHandler::_finish_batch_task(int64_t batch_id){
+	auto batch = get_batch(batch_id);
+	if (batch.is_null()){
+		return;
+	}
+
+	batch->wait();
+}
+
+// Wait for and drop every batch; called before the handler is unregistered.
+void DynmaicPrefixHandler::release_all_batches(){
+	Vector<Ref<DynamicLoadBatch>> batches;
+	{
+		MutexLock lock{**batch_mutex};
+		for (const auto &[key, batch] : load_batches){
+			batches.push_back(batch);
+		}
+		load_batches.clear();
+	}
+
+	for (const Ref<DynamicLoadBatch> &batch : batches){
+		batch->wait();
+	}
+}
+
+// Share one loaded resource between identifiers whose files have matching fingerprints; disabled by default.
+// The first load of every identifier reads and hashes its file once more, so only enable it for packs
+// with many duplicates. A shared instance's resource_path is the last path it was loaded through.
+void DynmaicPrefixHandler::set_content_deduplication(bool p_enabled){
+	content_deduplication = p_enabled;
+}
+
+bool DynmaicPrefixHandler::get_content_deduplication() const{
+	return content_deduplication;
+}
+
+// Keep up to budget_bytes of recently used resources of a content type loaded; 0 disables it.
+void DynmaicPrefixHandler::set_residency_budget(String content_type, int64_t budget_bytes){
+	residency_manager->set_budget(content_type, budget_bytes);
+}
+
+int64_t DynmaicPrefixHandler::get_residency_budget(String content_type){
+	return residency_manager->get_budget(content_type);
+}
+
+// Budget, resident bytes and hit/miss/eviction counts per content type.
+// Hits only count loads that reached the handler and explicit touch_resource calls.
+Dictionary DynmaicPrefixHandler::get_residency_stats(){
+	return residency_manager->get_stats();
+}
+
+// Evict resources that are no longer used elsewhere until every type is within budget.
+void DynmaicPrefixHandler::trim_residency(){
+	residency_manager->trim();
+}
+
+// Mark a resident dynamic resource as recently used.
+// Loads answered by Godot's ResourceCache never reach the handler, so scripts can report use here.
+void DynmaicPrefixHandler::touch_resource(String resource_path){
+	uint64_t generation = DynamicAssetIndexer::get_singleton()->get_index_generation();
+	Ref<Resource> resource = resource_cache->get_resource(resource_path, generation);
+	if (resource.is_valid()){
+		residency_manager->touch_resource(resource);
+	}
+}
 
-	return json_data;
+// Drop all resident resources; called before the handler is unregistered.
+void DynmaicPrefixHandler::release_resident_resources(){
+	residency_manager->clear();
 }
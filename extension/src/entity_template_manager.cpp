@@ -1,4 +1,5 @@
 #include "entity_template_manager.hpp"
+#include "asset_logger.hpp"
 
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/classes/file_access.hpp>
@@ -86,7 +87,7 @@ Dictionary EntityTemplateManager::get_entity_template(String entity_name) {
 
 	// Check cache first
 	if (template_cache.has(entity_name)) {
-		UtilityFunctions::print("Retrieved entity template from cache: ", entity_name);
+		EAM_LOG_DEBUG("Retrieved entity template from cache: ", entity_name);
 		return template_cache[entity_name];
 	}
 
@@ -115,11 +116,11 @@ Dictionary EntityTemplateManager::get_entity_template(String entity_name) {
 			}
 			
 			if (!found) {
-				UtilityFunctions::push_error("Entity file not found: ", entity_name, " (searched in ", base_path, ")");
+				EAM_LOG_ERROR("Entity file not found: ", entity_name, " (searched in ", base_path, ")");
 				return empty_dict;
 			}
 		} else {
-			UtilityFunctions::push_error("Failed to open entities directory: ", base_path);
+			EAM_LOG_ERROR("Failed to open entities directory: ", base_path);
 			return empty_dict;
 		}
 	}
@@ -129,7 +130,7 @@ Dictionary EntityTemplateManager::get_entity_template(String entity_name) {
 	XmlDocument doc = XmlLoader::parse_xml_string(entity_content.utf8().get_data());
 	
 	if (!doc.is_valid || !doc.root) {
-		UtilityFunctions::push_error("Failed to parse entity XML: ", entity_path);
+		EAM_LOG_ERROR("Failed to parse entity XML: ", entity_path);
 		return empty_dict;
 	}
 
@@ -139,7 +140,7 @@ Dictionary EntityTemplateManager::get_entity_template(String entity_name) {
 	// Cache it
 	template_cache[entity_name] = template_dict;
 	
-	UtilityFunctions::print("Loaded entity template: ", entity_name);
+	EAM_LOG_DEBUG("Loaded entity template: ", entity_name);
 	return template_dict;
 }
 
@@ -151,7 +152,7 @@ TypedArray<String> EntityTemplateManager::get_available_entities() {
 	
 	auto entities_dir = DirAccess::open(entities_path);
 	if (entities_dir == nullptr) {
-		UtilityFunctions::push_error("Failed to open entities directory: ", entities_path);
+		EAM_LOG_ERROR("Failed to open entities directory: ", entities_path);
 		return entities;
 	}
 
@@ -177,7 +178,7 @@ TypedArray<String> EntityTemplateManager::get_available_entities() {
 		}
 	}
 
-	UtilityFunctions::print("Found ", entities.size(), " entity templates");
+	EAM_LOG_DEBUG("Found ", entities.size(), " entity templates");
 	return entities;
 }
 
@@ -0,0 +1,304 @@
+#include "font_content_loader.hpp"
+#include "asset_logger.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/classes/resource_saver.hpp>
+
+#include "data_cache_manager.hpp"
+
+using namespace godot;
+
+// Copy stored font settings and rasterized glyphs, leaving out the font file bytes.
+static void _copy_font_without_data(const Ref<FontFile> &from, const Ref<FontFile> &to){
+	TypedArray<Dictionary> properties = from->get_property_list();
+	for (int64_t i = 0; i < properties.size(); i++){
+		Dictionary property = properties[i];
+		String name = property["name"];
+		int64_t usage = property["usage"];
+		if (!(usage & PROPERTY_USAGE_STORAGE) || name == "data"){
+			continue;
+		}
+
+		to->set(name, from->get(name));
+	}
+}
+
+void FontContentLoader::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_glyph_cache_enabled", "enabled"), &FontContentLoader::set_glyph_cache_enabled);
+	ClassDB::bind_method(D_METHOD("get_glyph_cache_enabled"), &FontContentLoader::get_glyph_cache_enabled);
+	ClassDB::bind_method(D_METHOD("set_msdf_enabled", "enabled"), &FontContentLoader::set_msdf_enabled);
+	ClassDB::bind_method(D_METHOD("get_msdf_enabled"), &FontContentLoader::get_msdf_enabled);
+	ClassDB::bind_method(D_METHOD("save_glyph_cache"), &FontContentLoader::save_glyph_cache);
+	ClassDB::bind_method(D_METHOD("clear_font_cache"), &FontContentLoader::clear_font_cache);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "glyph_cache_enabled"), "set_glyph_cache_enabled", "get_glyph_cache_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "msdf_enabled"), "set_msdf_enabled", "get_msdf_enabled");
+}
+
+FontContentLoader::FontContentLoader():font_mutex{memnew(godot::Mutex)} {}
+
+FontContentLoader::~FontContentLoader() {}
+
+String FontContentLoader::get_loader_name() const {
+	return "fonts";
+}
+
+String FontContentLoader::get_resource_type() const {
+	return "FontFile";
+}
+
+PackedStringArray FontContentLoader::get_recognized_extensions() const {
+	PackedStringArray extensions;
+	extensions.push_back("ttf");
+	extensions.push_back("ttc");
+	extensions.push_back("otf");
+	extensions.push_back("otc");
+	extensions.push_back("woff");
+	extensions.push_back("woff2");
+	extensions.push_back("pfb");
+	extensions.push_back("pfm");
+	return extensions;
+}
+
+bool FontContentLoader::is_thread_safe() const {
+	return true;
+}
+
+DynamicContentLoader::LoadThread FontContentLoader::get_preferred_thread() const {
+	return LOAD_THREAD_ANY;
+}
+
+DynamicContentLoader::CachePolicy FontContentLoader::get_cache_policy() const {
+	return CACHE_POLICY_SHARED;
+}
+
+// Create a font resource over the shared font bytes, restoring cached glyphs when enabled.
+Variant FontContentLoader::decode_from_path(const String &p_path) const {
+	SharedFontData font_data = get_shared_font_data(p_path);
+	if (font_data.data.is_empty()){
+		EAM_LOG_ERROR("error loading dynamic font: '" + p_path + "'");
+		return FAILED;
+	}
+
+	String entry_path = "";
+	Ref<FontFile> loaded_font{};
+	if (glyph_cache_enabled){
+		entry_path = get_glyph_cache_path(font_data.source_hash);
+		loaded_font = load_glyph_cache(entry_path, font_data.data);
+	}
+
+	if (loaded_font.is_null()){
+		loaded_font.instantiate();
+		loaded_font->set_multichannel_signed_distance_field(msdf_enabled);
+		loaded_font->set_data(font_data.data);
+	}
+
+	track_shared_font(p_path, font_data, loaded_font);
+
+	if (glyph_cache_enabled){
+		MutexLock lock{**font_mutex};
+		glyph_cache_fonts[entry_path] = UtilityFunctions::weakref(loaded_font);
+	}
+
+	return loaded_font;
+}
+
+// Dynamic fonts keep the whole font file in memory.
+int64_t FontContentLoader::estimate_resource_size(const Variant &p_resource, const String &p_path) const {
+	Ref<FontFile> font = p_resource;
+	if (font.is_null()){
+		return 0;
+	}
+
+	return font->get_data().size();
+}
+
+void FontContentLoader::set_glyph_cache_enabled(bool p_enabled){
+	glyph_cache_enabled = p_enabled;
+}
+
+bool FontContentLoader::get_glyph_cache_enabled() const{
+	return glyph_cache_enabled;
+}
+
+// Render new fonts as multichannel signed distance fields, which stay sharp at any size.
+void FontContentLoader::set_msdf_enabled(bool p_enabled){
+	msdf_enabled = p_enabled;
+}
+
+bool FontContentLoader::get_msdf_enabled() const{
+	return msdf_enabled;
+}
+
+// Read a font file once and reuse its bytes while fonts created from them are alive.
+// PackedByteArray is copy on write, so every FontFile references the same buffer.
+FontContentLoader::SharedFontData FontContentLoader::get_shared_font_data(const String &p_path) const{
+	uint64_t modified_time = FileAccess::get_modified_time(p_path);
+
+	SharedFontData font_data{};
+	{
+		MutexLock lock{**font_mutex};
+		release_unused_font_data();
+
+		auto entry = shared_font_data.find(p_path);
+		if (entry != shared_font_data.end() && entry->value.modified_time == modified_time){
+			font_data.data = entry->value.data;
+			font_data.modified_time = modified_time;
+			font_data.source_hash = entry->value.source_hash;
+		}
+	}
+
+	if (font_data.data.is_empty()){
+		font_data.data = FileAccess::get_file_as_bytes(p_path);
+		font_data.modified_time = modified_time;
+		if (font_data.data.is_empty()){
+			return font_data;
+		}
+	}
+
+	if (glyph_cache_enabled && font_data.source_hash == ""){
+		font_data.source_hash = DataCacheManager::hash_buffer(font_data.data, DataCacheManager::HASH_ALGORITHM_SHA256);
+	}
+
+	return font_data;
+}
+
+// Remember a font created over the shared bytes, adding the bytes if another thread dropped them.
+void FontContentLoader::track_shared_font(const String &p_path, const SharedFontData &font_data, const Ref<FontFile> &font) const{
+	MutexLock lock{**font_mutex};
+
+	auto entry = shared_font_data.find(p_path);
+	if (entry == shared_font_data.end() || entry->value.modified_time != font_data.modified_time){
+		SharedFontData new_entry{};
+		new_entry.data = font_data.data;
+		new_entry.modified_time = font_data.modified_time;
+		shared_font_data[p_path] = new_entry;
+		entry = shared_font_data.find(p_path);
+	}
+
+	if (entry->value.source_hash == ""){
+		entry->value.source_hash = font_data.source_hash;
+	}
+	entry->value.fonts.push_back(UtilityFunctions::weakref(font));
+}
+
+// Drop font bytes no live font uses anymore. Caller must hold font_mutex.
+void FontContentLoader::release_unused_font_data() const{
+	Vector<String> unused_paths;
+	for (auto &[path, font_data] : shared_font_data){
+		for (int64_t i = font_data.fonts.size() - 1; i >= 0; i--){
+			Ref<WeakRef> font_ref = font_data.fonts[i];
+			if (font_ref->get_ref().get_type() == Variant::NIL){
+				font_data.fonts.remove_at(i);
+			}
+		}
+
+		if (font_data.fonts.is_empty()){
+			unused_paths.push_back(path);
+		}
+	}
+
+	for (const String &path : unused_paths){
+		shared_font_data.erase(path);
+	}
+}
+
+// Glyph cache entries are keyed by font content hash and rendering mode;
+// every rasterized size is stored inside the entry.
+String FontContentLoader::get_glyph_cache_path(const String &source_hash) const{
+	return glyph_cache_dir + "/" + source_hash + (msdf_enabled ? ".msdf" : ".bitmap") + ".res";
+}
+
+// Create a font over the shared bytes and restore the cached glyphs into it.
+// The bytes are attached first, since setting font data clears every rasterized glyph.
+Ref<FontFile> FontContentLoader::load_glyph_cache(const String &entry_path, const PackedByteArray &data) const{
+	if (!FileAccess::file_exists(entry_path)){
+		return nullptr;
+	}
+
+	Ref<FontFile> cached_font = ResourceLoader::get_singleton()->load(entry_path, "FontFile", ResourceLoader::CACHE_MODE_IGNORE);
+	if (cached_font.is_null()){
+		EAM_LOG_WARNING("Ignoring unreadable font glyph cache: " + entry_path);
+		return nullptr;
+	}
+
+	Ref<FontFile> loaded_font{};
+	loaded_font.instantiate();
+	loaded_font->set_data(data);
+	_copy_font_without_data(cached_font, loaded_font);
+	return loaded_font;
+}
+
+// Write the glyphs rasterized so far for every live font; returns the number of entries saved.
+// Call from the main thread, e.g. after a text heavy menu was shown or before quitting.
+int32_t FontContentLoader::save_glyph_cache(){
+	HashMap<String, Ref<FontFile>> fonts;
+	{
+		MutexLock lock{**font_mutex};
+		Vector<String> dead_entries;
+		for (const auto &[entry_path, font_ref] : glyph_cache_fonts){
+			Ref<FontFile> font = font_ref->get_ref();
+			if (font.is_null()){
+				dead_entries.push_back(entry_path);
+				continue;
+			}
+			fonts[entry_path] = font;
+		}
+
+		for (const String &entry_path : dead_entries){
+			glyph_cache_fonts.erase(entry_path);
+		}
+	}
+
+	DirAccess::make_dir_recursive_absolute(glyph_cache_dir);
+
+	// Entries hold only glyphs and settings; the font file bytes come from the source file.
+	int32_t saved_count = 0;
+	for (const auto &[entry_path, font] : fonts){
+		Ref<FontFile> glyph_font{};
+		glyph_font.instantiate();
+		_copy_font_without_data(font, glyph_font);
+
+		String temp_path = entry_path.get_basename() + ".tmp.res";
+		Error err = ResourceSaver::get_singleton()->save(glyph_font, temp_path, ResourceSaver::FLAG_COMPRESS);
+		if (err != OK){
+			EAM_LOG_ERROR("Failed to save font glyph cache: " + entry_path);
+			DirAccess::remove_absolute(temp_path);
+			continue;
+		}
+
+		DirAccess::remove_absolute(entry_path);
+		if (DirAccess::rename_absolute(temp_path, entry_path) == OK){
+			saved_count++;
+		}else{
+			DirAccess::remove_absolute(temp_path);
+		}
+	}
+
+	return saved_count;
+}
+
+// Drop shared font bytes and delete all persisted glyph caches.
+void FontContentLoader::clear_font_cache(){
+	{
+		MutexLock lock{**font_mutex};
+		shared_font_data.clear();
+		glyph_cache_fonts.clear();
+	}
+
+	auto dir = DirAccess::open(glyph_cache_dir);
+	if (dir == nullptr){
+		return;
+	}
+
+	dir->list_dir_begin();
+	String entry = "";
+	while ((entry = dir->get_next()) != ""){
+		if (!dir->current_is_dir()){
+			dir->remove(entry);
+		}
+	}
+}
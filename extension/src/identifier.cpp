@@ -1,5 +1,7 @@
 #include "identifier.hpp"
+#include "asset_logger.hpp"
 #include <godot_cpp/core/class_db.hpp>
+#include "godot_cpp/classes/mutex.hpp"
 
 using namespace godot;
 
@@ -11,6 +13,8 @@ void Identifier::_bind_methods() {
 	ClassDB::bind_static_method("Identifier", D_METHOD("get_content_type_from_resouce", "_name"), &Identifier::get_content_type_from_resouce);
 	ClassDB::bind_static_method("Identifier", D_METHOD("get_resource_prefix_from_type", "_name"), &Identifier::get_resource_prefix_from_type);
 
+	ClassDB::bind_static_method("Identifier", D_METHOD("register_content_type", "_prefix", "_content_type"), &Identifier::register_content_type);
+
 	ClassDB::bind_static_method("Identifier", D_METHOD("get_all_resource_types"), &Identifier::get_all_resource_types);
 	ClassDB::bind_static_method("Identifier", D_METHOD("get_all_content_types"), &Identifier::get_all_content_types);
 
@@ -25,7 +29,7 @@ void Identifier::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_texture"), &Identifier::is_texture);
 }
 
-static inline HashMap<String, String> get_content_type_map() {
+static inline HashMap<String, String> get_default_content_type_map() {
 	HashMap<String, String> map;
 
 	map["dyn"] = "dynamic";
@@ -43,6 +47,27 @@ static inline HashMap<String, String> get_content_type_map() {
 	return map;
 }
 
+// Shared prefix -> content type map; extended at runtime through register_content_type.
+// Loader threads read it while scripts may register new prefixes, so every access holds get_content_type_mutex.
+static inline HashMap<String, String> &get_content_type_map() {
+	static HashMap<String, String> map = get_default_content_type_map();
+	return map;
+}
+
+static inline Ref<godot::Mutex> &get_content_type_mutex() {
+	static Ref<godot::Mutex> mutex{memnew(godot::Mutex)};
+	return mutex;
+}
+
+// Free the shared map and mutex before the engine shuts down instead of at static destruction.
+void Identifier::release_content_types() {
+	{
+		MutexLock lock{**get_content_type_mutex()};
+		get_content_type_map().clear();
+	}
+	get_content_type_mutex().unref();
+}
+
 Identifier::Identifier() {}
 
 Identifier::~Identifier() {}
@@ -61,7 +86,7 @@ String Identifier::get_resource_id() const {
 		// Use type-specific prefix for non-generic assets
 		return prefix + get_name();
 	}
-	UtilityFunctions::push_warning("Using generic prefix for resource id.");
+	EAM_LOG_WARNING("Using generic prefix for resource id.");
 	return "dyn://" + to_string();
 }
 
@@ -93,13 +118,14 @@ String Identifier::to_string() const {
 }
 
 String Identifier::get_content_type_from_resouce(String _name) {
-	const static HashMap<String, String> content_type_map = get_content_type_map();
-
 	if (!_name.contains("://")) {
 		return "";
 	}
 
 	String prefix = _name.split("://")[0];
+
+	MutexLock lock{**get_content_type_mutex()};
+	const HashMap<String, String> &content_type_map = get_content_type_map();
 	if (content_type_map.has(prefix)) {
 		return String{ content_type_map[prefix] };
 	}
@@ -108,7 +134,8 @@ String Identifier::get_content_type_from_resouce(String _name) {
 }
 
 String Identifier::get_resource_prefix_from_type(String _name) {
-	const static HashMap<String, String> content_type_map = get_content_type_map();
+	MutexLock lock{**get_content_type_mutex()};
+	const HashMap<String, String> &content_type_map = get_content_type_map();
 
 	for (const auto &[key, value] : content_type_map) {
 		if (value == _name) {
@@ -120,8 +147,20 @@ String Identifier::get_resource_prefix_from_type(String _name) {
 	return "dyn://";
 }
 
+// Register an additional resource prefix; safe to call while loads are running.
+void Identifier::register_content_type(String _prefix, String _content_type) {
+	if (_prefix == "" || _content_type == "") {
+		EAM_LOG_ERROR("Cannot register empty content type prefix or name.");
+		return;
+	}
+
+	MutexLock lock{**get_content_type_mutex()};
+	get_content_type_map()[_prefix] = _content_type;
+}
+
 TypedArray<String> Identifier::get_all_resource_types() {
-	const static HashMap<String, String> content_type_map = get_content_type_map();
+	MutexLock lock{**get_content_type_mutex()};
+	const HashMap<String, String> &content_type_map = get_content_type_map();
 
 	TypedArray<String> types;
 	for (const auto &[key, value] : content_type_map) {
@@ -132,7 +171,8 @@ TypedArray<String> Identifier::get_all_resource_types() {
 }
 
 TypedArray<String> Identifier::get_all_content_types() {
-	const static HashMap<String, String> content_type_map = get_content_type_map();
+	MutexLock lock{**get_content_type_mutex()};
+	const HashMap<String, String> &content_type_map = get_content_type_map();
 
 	TypedArray<String> types;
 	for (const auto &[key, value] : content_type_map) {
@@ -175,7 +215,7 @@ Ref<Identifier> Identifier::from_values(String _group, String _name) {
 Ref<Identifier> Identifier::for_resource(String _resource_path) {
 	String content_type = get_content_type_from_resouce(_resource_path);
 	if (content_type == "") {
-		UtilityFunctions::print("Failed to get content type from resource: " + _resource_path);
+		EAM_LOG_WARNING("Failed to get content type from resource: " + _resource_path);
 		return nullptr;
 	}
 	String prefix = get_resource_prefix_from_type(content_type);
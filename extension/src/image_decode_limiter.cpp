@@ -0,0 +1,212 @@
+#include "image_decode_limiter.hpp"
+#include "asset_logger.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
+
+#include <cstring>
+
+using namespace godot;
+
+// Bytes read from the start of a file when probing image dimensions.
+static constexpr int64_t IMAGE_HEADER_PROBE_SIZE = 64 * 1024;
+
+static inline uint32_t _read_u16_be(const uint8_t *p){
+	return (p[0] << 8) | p[1];
+}
+
+static inline uint32_t _read_u32_be(const uint8_t *p){
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline uint32_t _read_u24_le(const uint8_t *p){
+	return p[0] | (p[1] << 8) | (p[2] << 16);
+}
+
+// Width and height from a PNG IHDR chunk.
+static inline Vector2i _read_png_size(const uint8_t *data, int64_t size){
+	static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	if (size < 24 || memcmp(data, signature, 8) != 0){
+		return Vector2i();
+	}
+
+	return Vector2i(_read_u32_be(data + 16), _read_u32_be(data + 20));
+}
+
+// Width and height from the first WebP image chunk.
+static inline Vector2i _read_webp_size(const uint8_t *data, int64_t size){
+	if (size < 30 || memcmp(data, "RIFF", 4) != 0 || memcmp(data + 8, "WEBP", 4) != 0){
+		return Vector2i();
+	}
+
+	if (memcmp(data + 12, "VP8 ", 4) == 0){
+		return Vector2i((data[26] | (data[27] << 8)) & 0x3FFF, (data[28] | (data[29] << 8)) & 0x3FFF);
+	}else if (memcmp(data + 12, "VP8L", 4) == 0){
+		const uint8_t *b = data + 21;
+		int32_t width = 1 + (((b[1] & 0x3F) << 8) | b[0]);
+		int32_t height = 1 + (((b[3] & 0x0F) << 10) | (b[2] << 2) | ((b[1] & 0xC0) >> 6));
+		return Vector2i(width, height);
+	}else if (memcmp(data + 12, "VP8X", 4) == 0){
+		return Vector2i(1 + _read_u24_le(data + 24), 1 + _read_u24_le(data + 27));
+	}
+
+	return Vector2i();
+}
+
+// Width and height from the first JPEG start-of-frame segment.
+static inline Vector2i _read_jpg_size(const uint8_t *data, int64_t size){
+	if (size < 4 || data[0] != 0xFF || data[1] != 0xD8){
+		return Vector2i();
+	}
+
+	int64_t pos = 2;
+	while (pos + 9 < size){
+		if (data[pos] != 0xFF){
+			pos++;
+			continue;
+		}
+
+		uint8_t marker = data[pos + 1];
+		if (marker == 0xFF){
+			pos++;
+			continue;
+		}
+
+		// Markers without a length field.
+		if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD9)){
+			pos += 2;
+			continue;
+		}
+
+		bool is_frame = marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+		if (is_frame){
+			return Vector2i(_read_u16_be(data + pos + 7), _read_u16_be(data + pos + 5));
+		}
+
+		pos += 2 + _read_u16_be(data + pos + 2);
+	}
+
+	return Vector2i();
+}
+
+void ImageDecodeLimiter::_bind_methods() {}
+
+ImageDecodeLimiter::ImageDecodeLimiter():slot_mutex{memnew(godot::Mutex)}, slot_semaphore{memnew(godot::Semaphore)} {}
+
+ImageDecodeLimiter::~ImageDecodeLimiter() {}
+
+// Limit concurrent decodes; 0 or less uses one slot per processor.
+void ImageDecodeLimiter::set_max_concurrency(int32_t p_max_concurrency){
+	MutexLock lock{**slot_mutex};
+	max_concurrency = p_max_concurrency;
+
+	// Wake waiters so they re-check against the new limit.
+	while (waiting_decodes > 0){
+		waiting_decodes--;
+		slot_semaphore->post();
+	}
+}
+
+int32_t ImageDecodeLimiter::get_max_concurrency() const{
+	return max_concurrency;
+}
+
+// Block until a decode slot is free; also used for other CPU-heavy image work.
+void ImageDecodeLimiter::acquire_slot(){
+	while (true){
+		{
+			MutexLock lock{**slot_mutex};
+			int32_t limit = max_concurrency > 0 ? max_concurrency : OS::get_singleton()->get_processor_count();
+			if (active_decodes < limit){
+				active_decodes++;
+				return;
+			}
+			waiting_decodes++;
+		}
+
+		slot_semaphore->wait();
+	}
+}
+
+void ImageDecodeLimiter::release_slot(){
+	MutexLock lock{**slot_mutex};
+	active_decodes--;
+
+	if (waiting_decodes > 0){
+		waiting_decodes--;
+		slot_semaphore->post();
+	}
+}
+
+// Decode an in-memory image using the decoder for its file extension.
+Error ImageDecodeLimiter::decode_buffer(const Ref<Image> &image, const PackedByteArray &buffer, const String &extension){
+	if (extension == "png"){
+		return image->load_png_from_buffer(buffer);
+	}else if (extension == "jpg" || extension == "jpeg"){
+		return image->load_jpg_from_buffer(buffer);
+	}else if (extension == "webp"){
+		return image->load_webp_from_buffer(buffer);
+	}else if (extension == "bmp"){
+		return image->load_bmp_from_buffer(buffer);
+	}else if (extension == "tga"){
+		return image->load_tga_from_buffer(buffer);
+	}else if (extension == "svg"){
+		return image->load_svg_from_buffer(buffer);
+	}else if (extension == "ktx"){
+		return image->load_ktx_from_buffer(buffer);
+	}
+
+	return ERR_FILE_UNRECOGNIZED;
+}
+
+// Read and decode one image file on the calling thread.
+Ref<Image> ImageDecodeLimiter::decode_image(const String &file_path){
+	PackedByteArray buffer = FileAccess::get_file_as_bytes(file_path);
+	if (buffer.is_empty()){
+		EAM_LOG_ERROR("Failed to read image file: '" + file_path + "'");
+		return nullptr;
+	}
+
+	return decode_image_buffer(buffer, file_path);
+}
+
+// Decode an already read image file.
+Ref<Image> ImageDecodeLimiter::decode_image_buffer(const PackedByteArray &buffer, const String &file_path){
+	Ref<Image> image{};
+	image.instantiate();
+
+	acquire_slot();
+	Error err = decode_buffer(image, buffer, file_path.get_extension().to_lower());
+	release_slot();
+
+	if (err != OK){
+		EAM_LOG_ERROR("Failed to decode image file: '" + file_path + "'");
+		return nullptr;
+	}
+
+	return image;
+}
+
+// Read image dimensions from the file header without decoding pixels.
+// Supports PNG, JPEG and WebP; returns a zero size for other formats.
+Vector2i ImageDecodeLimiter::read_image_size(const String &file_path){
+	auto file = FileAccess::open(file_path, FileAccess::READ);
+	if (file == nullptr){
+		return Vector2i();
+	}
+
+	PackedByteArray header = file->get_buffer(IMAGE_HEADER_PROBE_SIZE);
+	file->close();
+
+	String extension = file_path.get_extension().to_lower();
+	if (extension == "png"){
+		return _read_png_size(header.ptr(), header.size());
+	}else if (extension == "jpg" || extension == "jpeg"){
+		return _read_jpg_size(header.ptr(), header.size());
+	}else if (extension == "webp"){
+		return _read_webp_size(header.ptr(), header.size());
+	}
+
+	return Vector2i();
+}
@@ -1,4 +1,5 @@
 #include "identifier.hpp"
+#include "asset_logger.hpp"
 #include "data_cache_manager.hpp"
 #include "xml_loader.hpp"
 
@@ -46,7 +47,7 @@ static inline Ref<Translation> _load_translation_from_json(JSON* lang_data, Stri
 static inline void _load_lang_files(String pack_path, String asset_group, HashMap<String, String>& asset_map){
 	auto lang_dir = DirAccess::open(pack_path + "/" + asset_group + "/lang");
 	if (lang_dir == nullptr){
-		UtilityFunctions::print("Failed to open lang directory for " + asset_group + " in " + pack_path);
+		EAM_LOG_WARNING("Failed to open lang directory for " + asset_group + " in " + pack_path);
 		return;
 	}
 
@@ -67,18 +68,18 @@ static inline void _load_lang_files(String pack_path, String asset_group, HashMa
 
 		Ref<Resource> raw_lang_data = ResourceLoader::get_singleton()->load(lang_path);
 		if (raw_lang_data == nullptr || !raw_lang_data.is_valid()){
-			UtilityFunctions::print("Failed to load lang file: " + lang_path);
+			EAM_LOG_ERROR("Failed to load lang file: " + lang_path);
 			continue;
 		}
 
 		if (!raw_lang_data->is_class("JSON")){
-			UtilityFunctions::print("Lang file is not a JSON file: " + lang_path);
+			EAM_LOG_ERROR("Lang file is not a JSON file: " + lang_path);
 			continue;
 		}
 
 		auto lang_data = Object::cast_to<JSON>(raw_lang_data.ptr());
 		if (lang_data == nullptr){
-			UtilityFunctions::print("Failed to cast lang data to JSON: " + lang_path);
+			EAM_LOG_ERROR("Failed to cast lang data to JSON: " + lang_path);
 			continue;
 		}
 
@@ -92,11 +93,11 @@ static inline void _load_lang_files(String pack_path, String asset_group, HashMa
 static inline void _index_fonts(String pack_path, String asset_group, HashMap<String, String>& asset_map){
 	auto font_dir = DirAccess::open(pack_path + "/" + asset_group + "/fonts");
 	if (font_dir == nullptr){
-		UtilityFunctions::print("Failed to open font directory");
+		EAM_LOG_WARNING("Failed to open font directory");
 		return;
 	}
 	
-	UtilityFunctions::print("loading fonts for " + pack_path + "/" + asset_group);
+	EAM_LOG_DEBUG("loading fonts for " + pack_path + "/" + asset_group);
 
 	font_dir->list_dir_begin();
 	String font_name = "";
@@ -116,7 +117,7 @@ static inline void _index_fonts(String pack_path, String asset_group, HashMap<St
 		Ref<Identifier> font_id = Identifier::from_values(asset_group, "fonts/" + font_basename);
 
 		asset_map[font_id->to_string()] = font_path;
-		UtilityFunctions::print("Indexed font: " + font_id->to_string());
+		EAM_LOG_DEBUG("Indexed font: " + font_id->to_string());
 		
 	}
 }
@@ -127,7 +128,7 @@ static inline void _index_fonts(String pack_path, String asset_group, HashMap<St
 static inline void _cache_patch_data(String pack_path, String asset_group, HashMap<String, String>& asset_map){
 	auto patches_dir = DirAccess::open(pack_path + "/" + asset_group + "/patchdata");
 	if (patches_dir == nullptr){
-		UtilityFunctions::print("Failed to open patchdata directory");
+		EAM_LOG_WARNING("Failed to open patchdata directory");
 		return;
 	}
 
@@ -139,12 +140,12 @@ static inline void _cache_patch_data(String pack_path, String asset_group, HashM
 			continue;
 		}
 
-		UtilityFunctions::print("Caching patch data for gamemode: " + gamemode_name);
+		EAM_LOG_DEBUG("Caching patch data for gamemode: " + gamemode_name);
 
 		String manifest_path = pack_path + "/" + asset_group + "/patchdata/" + gamemode_name + "/manifest.json";
 		Ref<Identifier> manifest_id = Identifier::for_resource("gamemode://" + asset_group + ":" + gamemode_name);
 		if (manifest_id == nullptr){
-			UtilityFunctions::print("Failed to create manifest identifier");
+			EAM_LOG_ERROR("Failed to create manifest identifier");
 			continue;
 		}
 		asset_map[manifest_id->to_string()] = manifest_path;
@@ -155,7 +156,7 @@ static inline void _cache_patch_data(String pack_path, String asset_group, HashM
 
 			auto gamemode_dir = DirAccess::open(pack_path + "/" + asset_group + "/patchdata/" + gamemode_name + "/" + patch_type);
 			if (gamemode_dir == nullptr){
-				UtilityFunctions::print("Failed to open gamemode directory: " + gamemode_name);
+				EAM_LOG_ERROR("Failed to open gamemode directory: " + gamemode_name);
 				continue;
 			}
 
@@ -173,7 +174,7 @@ static inline void _cache_patch_data(String pack_path, String asset_group, HashM
 				String patch_path = pack_path + "/" + asset_group + "/patchdata/" + gamemode_name + "/" + patch_type + "/" + patch_file;
 				String file_hash = DataCacheManager::get_singleton()->cache_file(patch_path);
 				
-				UtilityFunctions::print("Cached file '" + patch_path + "' with hash: " + file_hash);
+				EAM_LOG_DEBUG("Cached file '" + patch_path + "' with hash: " + file_hash);
 			}
 		}
 	}
@@ -183,7 +184,7 @@ static inline void _cache_patch_data(String pack_path, String asset_group, HashM
 static inline void _load_entity_data(String pack_path, String asset_group, HashMap<String, String>& asset_map){
 	auto entities_dir = DirAccess::open(pack_path + "/" + asset_group + "/entities");
 	if (entities_dir == nullptr){
-		UtilityFunctions::print("Failed to open entities directory");
+		EAM_LOG_WARNING("Failed to open entities directory");
 		return;
 	}
 
@@ -204,25 +205,25 @@ static inline void _load_entity_data(String pack_path, String asset_group, HashM
 		// Load and parse XML file
 		XmlDocument doc = XmlLoader::load_xml_file(entity_path.utf8().get_data());
 		if (!doc.is_valid){
-			UtilityFunctions::push_error("Failed to load entity XML: ", entity_path);
+			EAM_LOG_ERROR("Failed to load entity XML: ", entity_path);
 			continue;
 		}
 
 		if (!doc.root){
-			UtilityFunctions::push_error("Entity XML has no root node: ", entity_path);
+			EAM_LOG_ERROR("Entity XML has no root node: ", entity_path);
 			continue;
 		}
 
 		// Get entity ID from root element
 		XmlAttribute id_attr = doc.root->get_attribute("id");
 		if (id_attr.string_value.empty()){
-			UtilityFunctions::push_error("Entity XML missing id attribute: ", entity_path);
+			EAM_LOG_ERROR("Entity XML missing id attribute: ", entity_path);
 			continue;
 		}
 
 		// Cache the entire entity file
 		String file_hash = DataCacheManager::get_singleton()->cache_file(entity_path);
-		UtilityFunctions::print("Cached entity file '" + entity_path + "' with ID: " + String(id_attr.string_value.c_str()) + " hash: " + file_hash);
+		EAM_LOG_DEBUG("Cached entity file '" + entity_path + "' with ID: " + String(id_attr.string_value.c_str()) + " hash: " + file_hash);
 	}
 }
 
@@ -238,11 +239,11 @@ static inline void _index_resources(
 ){
 	auto resource_dir = DirAccess::open(pack_path + "/" + asset_group + "/" + resource_subdir);
 	if (resource_dir == nullptr){
-		UtilityFunctions::push_error("Failed to open " + resource_type + " directory");
+		EAM_LOG_ERROR("Failed to open " + resource_type + " directory");
 		return;
 	}
 	
-	UtilityFunctions::print("loading " + resource_type + " for " + pack_path + "/" + asset_group + "/" + resource_subdir);
+	EAM_LOG_DEBUG("loading " + resource_type + " for " + pack_path + "/" + asset_group + "/" + resource_subdir);
 
 	resource_dir->list_dir_begin();
 	String resource_name = "";
@@ -266,8 +267,7 @@ static inline void _index_resources(
 			Ref<Identifier> resource_id = Identifier::from_values(asset_group, resource_subdir + "/" + resource_basename);
 
 			asset_map[resource_id->to_string()] = resource_path;
-			UtilityFunctions::print("Indexed " + resource_type + ": " + resource_id->to_string());
-			UtilityFunctions::print(" at path: " + resource_path);
+			EAM_LOG_DEBUG("Indexed " + resource_type + ": " + resource_id->to_string() + " at path: " + resource_path);
 		}
 	}
 }
@@ -277,7 +277,7 @@ static inline void _index_resources(
 static inline void _index_asset_group(String pack_path, String asset_group, HashMap<String, String>& asset_map){
 	auto group_dir = DirAccess::open(pack_path + "/" + asset_group);
 	if (group_dir == nullptr){
-		UtilityFunctions::push_error("Failed to open group directory: " + asset_group);
+		EAM_LOG_ERROR("Failed to open group directory: " + asset_group);
 		return;
 	}
 
@@ -285,7 +285,7 @@ static inline void _index_asset_group(String pack_path, String asset_group, Hash
 	String asset_type = group_dir->get_next();
 
 	while (asset_type != ""){
-        UtilityFunctions::print("Indexing asset type: " + asset_type + " in " + pack_path + "/" + asset_group);
+        EAM_LOG_DEBUG("Indexing asset type: " + asset_type + " in " + pack_path + "/" + asset_group);
 		if (group_dir->current_is_dir()){
 			// Use different function depending on asset type.
 			if (asset_type == "lang"){
@@ -310,7 +310,7 @@ static inline void _index_asset_group(String pack_path, String asset_group, Hash
 static inline void _index_asset_pack(String pack_path, HashMap<String, String>& asset_map){
 	auto pack_dir = DirAccess::open(pack_path);
 	if (pack_dir == nullptr){
-		UtilityFunctions::push_error("Failed to open pack directory: " + pack_path);
+		EAM_LOG_ERROR("Failed to open pack directory: " + pack_path);
 		return;
 	}
 
@@ -318,7 +318,7 @@ static inline void _index_asset_pack(String pack_path, HashMap<String, String>&
 	String asset_group = pack_dir->get_next();
 
 	while (asset_group != ""){
-        UtilityFunctions::print("Indexing asset group: " + asset_group + " in " + pack_path);
+        EAM_LOG_DEBUG("Indexing asset group: " + asset_group + " in " + pack_path);
 
 		if (pack_dir->current_is_dir()){
 			_index_asset_group(pack_path, asset_group, asset_map);
@@ -0,0 +1,190 @@
+#include "json_content_loader.hpp"
+#include "asset_logger.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
+
+#include "data_cache_manager.hpp"
+
+using namespace godot;
+
+// "EAMJ" in little endian.
+static constexpr uint32_t JSON_CACHE_MAGIC = 0x4A4D4145;
+static constexpr uint32_t JSON_CACHE_VERSION = 1;
+
+void JsonContentLoader::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_binary_cache_enabled", "enabled"), &JsonContentLoader::set_binary_cache_enabled);
+	ClassDB::bind_method(D_METHOD("get_binary_cache_enabled"), &JsonContentLoader::get_binary_cache_enabled);
+	ClassDB::bind_method(D_METHOD("clear_json_cache"), &JsonContentLoader::clear_json_cache);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "binary_cache_enabled"), "set_binary_cache_enabled", "get_binary_cache_enabled");
+}
+
+JsonContentLoader::JsonContentLoader() {}
+
+JsonContentLoader::~JsonContentLoader() {}
+
+String JsonContentLoader::get_loader_name() const {
+	return "json";
+}
+
+String JsonContentLoader::get_resource_type() const {
+	return "JSON";
+}
+
+PackedStringArray JsonContentLoader::get_recognized_extensions() const {
+	PackedStringArray extensions;
+	extensions.push_back("json");
+	return extensions;
+}
+
+bool JsonContentLoader::is_thread_safe() const {
+	return true;
+}
+
+DynamicContentLoader::LoadThread JsonContentLoader::get_preferred_thread() const {
+	return LOAD_THREAD_ANY;
+}
+
+DynamicContentLoader::CachePolicy JsonContentLoader::get_cache_policy() const {
+	return CACHE_POLICY_SHARED;
+}
+
+// Load JSON file and create JSON resource.
+// Files seen before are restored from the binary cache without parsing the text.
+Variant JsonContentLoader::decode_from_path(const String &p_path) const {
+	PackedByteArray source = FileAccess::get_file_as_bytes(p_path);
+	if (source.is_empty() && FileAccess::get_open_error() != OK){
+		EAM_LOG_ERROR("error dynamic json not in file loader: '" + p_path + "'");
+		return FAILED;
+	}
+
+	Ref<JSON> json_data{};
+	json_data.instantiate();
+
+	String source_hash = "";
+	if (binary_cache_enabled){
+		source_hash = DataCacheManager::hash_buffer(source, DataCacheManager::HASH_ALGORITHM_SHA256);
+
+		Variant cached_data{};
+		if (load_cached_data(source_hash, cached_data)){
+			json_data->set_data(cached_data);
+			return json_data;
+		}
+	}
+
+	auto error = json_data->parse(source.get_string_from_utf8());
+
+	if (error != OK){
+		EAM_LOG_ERROR("error parsing dynamic json: '" + p_path + "'");
+		return FAILED;
+	}
+
+	if (binary_cache_enabled){
+		store_cached_data(source_hash, json_data->get_data());
+	}
+
+	return json_data;
+}
+
+void JsonContentLoader::set_binary_cache_enabled(bool p_enabled){
+	binary_cache_enabled = p_enabled;
+}
+
+bool JsonContentLoader::get_binary_cache_enabled() const{
+	return binary_cache_enabled;
+}
+
+String JsonContentLoader::get_entry_path(const String &source_hash) const{
+	return cache_dir + "/" + source_hash + ".eamjson";
+}
+
+// Read parsed data for a source hash; returns false when there is no valid entry.
+bool JsonContentLoader::load_cached_data(const String &source_hash, Variant &r_data) const{
+	String entry_path = get_entry_path(source_hash);
+	if (!FileAccess::file_exists(entry_path)){
+		return false;
+	}
+
+	auto file = FileAccess::open(entry_path, FileAccess::READ);
+	if (file == nullptr){
+		return false;
+	}
+
+	if (file->get_32() != JSON_CACHE_MAGIC || file->get_32() != JSON_CACHE_VERSION){
+		EAM_LOG_WARNING("Ignoring outdated json cache entry: " + entry_path);
+		return false;
+	}
+
+	// The entry name already carries the hash; the stored copy guards against renamed or mixed up files.
+	if (file->get_pascal_string() != source_hash){
+		EAM_LOG_WARNING("Ignoring mismatched json cache entry: " + entry_path);
+		return false;
+	}
+
+	uint64_t data_size = file->get_64();
+	PackedByteArray data = file->get_buffer(data_size);
+	file->close();
+
+	if ((uint64_t)data.size() != data_size){
+		EAM_LOG_WARNING("Truncated json cache entry: " + entry_path);
+		return false;
+	}
+
+	// bytes_to_var returns null for data it cannot decode; only an encoded null may decode to it.
+	r_data = UtilityFunctions::bytes_to_var(data);
+	if (r_data.get_type() == Variant::NIL && data != UtilityFunctions::var_to_bytes(Variant())){
+		EAM_LOG_WARNING("Removing corrupt json cache entry: " + entry_path);
+		DirAccess::remove_absolute(entry_path);
+		return false;
+	}
+
+	return true;
+}
+
+// Write parsed data through a temporary file so readers never see partial entries.
+Error JsonContentLoader::store_cached_data(const String &source_hash, const Variant &data) const{
+	DirAccess::make_dir_recursive_absolute(cache_dir);
+
+	String entry_path = get_entry_path(source_hash);
+	String temp_path = entry_path + ".tmp" + String::num_uint64(OS::get_singleton()->get_thread_caller_id());
+
+	auto file = FileAccess::open(temp_path, FileAccess::WRITE);
+	if (file == nullptr){
+		EAM_LOG_ERROR("Failed to open json cache file for writing: " + temp_path);
+		return ERR_FILE_CANT_WRITE;
+	}
+
+	PackedByteArray encoded = UtilityFunctions::var_to_bytes(data);
+
+	file->store_32(JSON_CACHE_MAGIC);
+	file->store_32(JSON_CACHE_VERSION);
+	file->store_pascal_string(source_hash);
+	file->store_64(encoded.size());
+	file->store_buffer(encoded);
+	file->close();
+
+	Error err = DirAccess::rename_absolute(temp_path, entry_path);
+	if (err != OK){
+		DirAccess::remove_absolute(temp_path);
+	}
+	return err;
+}
+
+// Remove all cached json entries.
+void JsonContentLoader::clear_json_cache() const{
+	auto dir = DirAccess::open(cache_dir);
+	if (dir == nullptr){
+		return;
+	}
+
+	dir->list_dir_begin();
+	String entry = "";
+	while ((entry = dir->get_next()) != ""){
+		if (!dir->current_is_dir()){
+			dir->remove(entry);
+		}
+	}
+}
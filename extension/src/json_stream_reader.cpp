@@ -0,0 +1,659 @@
+#include "json_stream_reader.hpp"
+#include "asset_logger.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+static inline int32_t _hex_digit_value(int32_t c){
+	if (c >= '0' && c <= '9'){
+		return c - '0';
+	}
+	if (c >= 'a' && c <= 'f'){
+		return c - 'a' + 10;
+	}
+	if (c >= 'A' && c <= 'F'){
+		return c - 'A' + 10;
+	}
+	return -1;
+}
+
+// Expose JsonStreamReader methods to Godot.
+void JsonStreamReader::_bind_methods() {
+	ClassDB::bind_static_method("JsonStreamReader", D_METHOD("validate_file", "file_path"), &JsonStreamReader::validate_file);
+	ClassDB::bind_static_method("JsonStreamReader", D_METHOD("extract_from_file", "file_path", "key_path"), &JsonStreamReader::extract_from_file);
+
+	ClassDB::bind_method(D_METHOD("open", "file_path", "read_buffer_size"), &JsonStreamReader::open, DEFVAL(DEFAULT_BUFFER_SIZE));
+	ClassDB::bind_method(D_METHOD("open_buffer", "data"), &JsonStreamReader::open_buffer);
+	ClassDB::bind_method(D_METHOD("close"), &JsonStreamReader::close);
+
+	ClassDB::bind_method(D_METHOD("read_next"), &JsonStreamReader::read_next);
+	ClassDB::bind_method(D_METHOD("get_token"), &JsonStreamReader::get_token);
+	ClassDB::bind_method(D_METHOD("get_key"), &JsonStreamReader::get_key);
+	ClassDB::bind_method(D_METHOD("get_value"), &JsonStreamReader::get_value);
+	ClassDB::bind_method(D_METHOD("get_depth"), &JsonStreamReader::get_depth);
+
+	ClassDB::bind_method(D_METHOD("read_value"), &JsonStreamReader::read_value);
+	ClassDB::bind_method(D_METHOD("skip_value"), &JsonStreamReader::skip_value);
+	ClassDB::bind_method(D_METHOD("validate"), &JsonStreamReader::validate);
+	ClassDB::bind_method(D_METHOD("extract", "key_path"), &JsonStreamReader::extract);
+
+	ClassDB::bind_method(D_METHOD("get_error"), &JsonStreamReader::get_error);
+	ClassDB::bind_method(D_METHOD("get_error_message"), &JsonStreamReader::get_error_message);
+	ClassDB::bind_method(D_METHOD("get_error_line"), &JsonStreamReader::get_error_line);
+
+	BIND_ENUM_CONSTANT(TOKEN_NONE);
+	BIND_ENUM_CONSTANT(TOKEN_OBJECT_BEGIN);
+	BIND_ENUM_CONSTANT(TOKEN_OBJECT_END);
+	BIND_ENUM_CONSTANT(TOKEN_ARRAY_BEGIN);
+	BIND_ENUM_CONSTANT(TOKEN_ARRAY_END);
+	BIND_ENUM_CONSTANT(TOKEN_VALUE);
+	BIND_ENUM_CONSTANT(TOKEN_END);
+	BIND_ENUM_CONSTANT(TOKEN_ERROR);
+}
+
+// Editors on Windows often save UTF-8 files with a byte order mark, which JSON.parse accepts.
+static inline bool _has_utf8_bom(const uint8_t *data, int64_t length){
+	return length >= 3 && data[0] == 0xEF && data[1] == 0xBB && data[2] == 0xBF;
+}
+
+JsonStreamReader::JsonStreamReader() {}
+
+JsonStreamReader::~JsonStreamReader() {
+	close();
+}
+
+// Start reading a JSON file, keeping at most read_buffer_size bytes of it in memory.
+Error JsonStreamReader::open(String file_path, int64_t read_buffer_size){
+	reset();
+
+	file = FileAccess::open(file_path, FileAccess::READ);
+	if (file == nullptr){
+		error = ERR_FILE_CANT_OPEN;
+		error_message = "Failed to open file: " + file_path;
+		return error;
+	}
+
+	buffer_size = MAX(read_buffer_size, (int64_t)64);
+
+	PackedByteArray head = file->get_buffer(3);
+	if (!_has_utf8_bom(head.ptr(), head.size())){
+		file->seek(0);
+	}
+	return OK;
+}
+
+// Start reading JSON that is already in memory.
+Error JsonStreamReader::open_buffer(PackedByteArray data){
+	reset();
+
+	buffer = data;
+	buffer_ptr = buffer.ptr();
+	buffer_len = buffer.size();
+	if (_has_utf8_bom(buffer_ptr, buffer_len)){
+		buffer_pos = 3;
+	}
+	return OK;
+}
+
+void JsonStreamReader::close(){
+	if (file.is_valid()){
+		file->close();
+		file.unref();
+	}
+
+	buffer.clear();
+	buffer_ptr = nullptr;
+	buffer_pos = 0;
+	buffer_len = 0;
+}
+
+void JsonStreamReader::reset(){
+	close();
+
+	containers.clear();
+	token_bytes.clear();
+	needs_separator = false;
+	root_done = false;
+	skipping = false;
+
+	current_token = TOKEN_NONE;
+	current_key = "";
+	current_value = Variant();
+
+	error = OK;
+	error_message = "";
+	line = 1;
+}
+
+// Replace the buffer with the next chunk of the file.
+bool JsonStreamReader::refill(){
+	if (file.is_null()){
+		return false;
+	}
+
+	buffer = file->get_buffer(buffer_size);
+	buffer_ptr = buffer.ptr();
+	buffer_pos = 0;
+	buffer_len = buffer.size();
+	return buffer_len > 0;
+}
+
+// Next byte without consuming it, or -1 at the end of the input.
+int32_t JsonStreamReader::peek(){
+	if (buffer_pos >= buffer_len && !refill()){
+		return -1;
+	}
+
+	return buffer_ptr[buffer_pos];
+}
+
+int32_t JsonStreamReader::next(){
+	int32_t c = peek();
+	if (c < 0){
+		return c;
+	}
+
+	buffer_pos++;
+	if (c == '\n'){
+		line++;
+	}
+	return c;
+}
+
+void JsonStreamReader::skip_whitespace(){
+	int32_t c = peek();
+	while (c == ' ' || c == '\t' || c == '\n' || c == '\r'){
+		next();
+		c = peek();
+	}
+}
+
+JsonStreamReader::Token JsonStreamReader::set_error(const String &message){
+	error = ERR_PARSE_ERROR;
+	error_message = message;
+	current_token = TOKEN_ERROR;
+	return current_token;
+}
+
+// Advance to the next token. Members of an object carry their key in get_key().
+JsonStreamReader::Token JsonStreamReader::read_next(){
+	if (current_token == TOKEN_END || current_token == TOKEN_ERROR){
+		return current_token;
+	}
+
+	current_key = "";
+	current_value = Variant();
+
+	if (root_done){
+		skip_whitespace();
+		if (peek() >= 0){
+			return set_error("Unexpected data after the root value");
+		}
+
+		current_token = TOKEN_END;
+		return current_token;
+	}
+
+	if (containers.is_empty()){
+		return read_value_token();
+	}
+
+	skip_whitespace();
+
+	Container container = containers[containers.size() - 1];
+	int32_t close_char = container == CONTAINER_OBJECT ? '}' : ']';
+
+	int32_t c = peek();
+	if (c == close_char){
+		next();
+		containers.resize(containers.size() - 1);
+		return finish_value(container == CONTAINER_OBJECT ? TOKEN_OBJECT_END : TOKEN_ARRAY_END);
+	}
+
+	if (needs_separator){
+		if (c != ','){
+			return set_error(c < 0 ? "Unexpected end of file" : "Expected ',' or closing bracket");
+		}
+
+		next();
+		skip_whitespace();
+		c = peek();
+		if (c == close_char){
+			return set_error("Trailing comma");
+		}
+	}
+
+	if (container == CONTAINER_OBJECT){
+		if (c != '"'){
+			return set_error("Expected string key");
+		}
+		if (!parse_string(current_key)){
+			return current_token;
+		}
+
+		skip_whitespace();
+		if (next() != ':'){
+			return set_error("Expected ':' after key");
+		}
+	}
+
+	return read_value_token();
+}
+
+JsonStreamReader::Token JsonStreamReader::read_value_token(){
+	skip_whitespace();
+
+	int32_t c = peek();
+	switch (c){
+		case '{':
+		case '[': {
+			if (containers.size() >= (uint32_t)MAX_DEPTH){
+				return set_error("Nesting too deep");
+			}
+
+			next();
+			containers.push_back(c == '{' ? CONTAINER_OBJECT : CONTAINER_ARRAY);
+			needs_separator = false;
+			current_token = c == '{' ? TOKEN_OBJECT_BEGIN : TOKEN_ARRAY_BEGIN;
+			return current_token;
+		}
+		case '"': {
+			String value = "";
+			if (!parse_string(value)){
+				return current_token;
+			}
+			current_value = value;
+			return finish_value(TOKEN_VALUE);
+		}
+		case 't':
+			return parse_literal("true", true, current_value) ? finish_value(TOKEN_VALUE) : current_token;
+		case 'f':
+			return parse_literal("false", false, current_value) ? finish_value(TOKEN_VALUE) : current_token;
+		case 'n':
+			return parse_literal("null", Variant(), current_value) ? finish_value(TOKEN_VALUE) : current_token;
+		case -1:
+			return set_error("Unexpected end of file");
+		default:
+			break;
+	}
+
+	if (c == '-' || (c >= '0' && c <= '9')){
+		return parse_number(current_value) ? finish_value(TOKEN_VALUE) : current_token;
+	}
+
+	return set_error("Unexpected character");
+}
+
+// A complete value was read; the root or the enclosing container moves on.
+JsonStreamReader::Token JsonStreamReader::finish_value(Token token){
+	if (containers.is_empty()){
+		root_done = true;
+	}else{
+		needs_separator = true;
+	}
+
+	current_token = token;
+	return current_token;
+}
+
+// Read a quoted string, resolving escapes. Contents are dropped while skipping.
+bool JsonStreamReader::parse_string(String &r_string){
+	next();
+	token_bytes.clear();
+
+	auto read_hex4 = [this]() -> int32_t {
+		int32_t value = 0;
+		for (int32_t i = 0; i < 4; i++){
+			int32_t digit = _hex_digit_value(next());
+			if (digit < 0){
+				return -1;
+			}
+			value = (value << 4) | digit;
+		}
+		return value;
+	};
+
+	while (true){
+		int32_t c = next();
+		if (c < 0){
+			set_error("Unterminated string");
+			return false;
+		}
+		if (c == '"'){
+			break;
+		}
+		if (c < 0x20){
+			set_error("Control character in string");
+			return false;
+		}
+
+		if (c != '\\'){
+			if (!skipping){
+				token_bytes.push_back((char)c);
+			}
+			continue;
+		}
+
+		int32_t escape = next();
+		switch (escape){
+			case '"':
+			case '\\':
+			case '/':
+				append_codepoint(escape);
+				break;
+			case 'b':
+				append_codepoint('\b');
+				break;
+			case 'f':
+				append_codepoint('\f');
+				break;
+			case 'n':
+				append_codepoint('\n');
+				break;
+			case 'r':
+				append_codepoint('\r');
+				break;
+			case 't':
+				append_codepoint('\t');
+				break;
+			case 'u': {
+				int32_t codepoint = read_hex4();
+				if (codepoint < 0){
+					set_error("Invalid unicode escape");
+					return false;
+				}
+
+				if (codepoint >= 0xD800 && codepoint <= 0xDBFF){
+					if (next() != '\\' || next() != 'u'){
+						set_error("Unpaired surrogate in unicode escape");
+						return false;
+					}
+
+					int32_t low = read_hex4();
+					if (low < 0xDC00 || low > 0xDFFF){
+						set_error("Unpaired surrogate in unicode escape");
+						return false;
+					}
+					codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+				}else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF){
+					set_error("Unpaired surrogate in unicode escape");
+					return false;
+				}
+
+				append_codepoint(codepoint);
+				break;
+			}
+			default:
+				set_error("Invalid escape sequence");
+				return false;
+		}
+	}
+
+	if (!skipping){
+		r_string = token_bytes.is_empty() ? String() : String::utf8(token_bytes.ptr(), token_bytes.size());
+	}
+	return true;
+}
+
+// Append a code point to the token as UTF-8.
+void JsonStreamReader::append_codepoint(uint32_t codepoint){
+	if (skipping){
+		return;
+	}
+
+	if (codepoint < 0x80){
+		token_bytes.push_back((char)codepoint);
+	}else if (codepoint < 0x800){
+		token_bytes.push_back((char)(0xC0 | (codepoint >> 6)));
+		token_bytes.push_back((char)(0x80 | (codepoint & 0x3F)));
+	}else if (codepoint < 0x10000){
+		token_bytes.push_back((char)(0xE0 | (codepoint >> 12)));
+		token_bytes.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+		token_bytes.push_back((char)(0x80 | (codepoint & 0x3F)));
+	}else{
+		token_bytes.push_back((char)(0xF0 | (codepoint >> 18)));
+		token_bytes.push_back((char)(0x80 | ((codepoint >> 12) & 0x3F)));
+		token_bytes.push_back((char)(0x80 | ((codepoint >> 6) & 0x3F)));
+		token_bytes.push_back((char)(0x80 | (codepoint & 0x3F)));
+	}
+}
+
+// Read a number with strict JSON grammar. Like JSON.parse, every number becomes a float.
+bool JsonStreamReader::parse_number(Variant &r_value){
+	token_bytes.clear();
+
+	auto take_digits = [this]() -> int32_t {
+		int32_t count = 0;
+		while (peek() >= '0' && peek() <= '9'){
+			token_bytes.push_back((char)next());
+			count++;
+		}
+		return count;
+	};
+
+	if (peek() == '-'){
+		token_bytes.push_back((char)next());
+	}
+
+	if (peek() == '0'){
+		token_bytes.push_back((char)next());
+	}else if (take_digits() == 0){
+		set_error("Invalid number");
+		return false;
+	}
+
+	if (peek() == '.'){
+		token_bytes.push_back((char)next());
+		if (take_digits() == 0){
+			set_error("Invalid number");
+			return false;
+		}
+	}
+
+	if (peek() == 'e' || peek() == 'E'){
+		token_bytes.push_back((char)next());
+		if (peek() == '+' || peek() == '-'){
+			token_bytes.push_back((char)next());
+		}
+		if (take_digits() == 0){
+			set_error("Invalid number");
+			return false;
+		}
+	}
+
+	if (!skipping){
+		token_bytes.push_back('\0');
+		r_value = String(token_bytes.ptr()).to_float();
+	}
+	return true;
+}
+
+bool JsonStreamReader::parse_literal(const char *literal, const Variant &value, Variant &r_value){
+	for (const char *c = literal; *c != '\0'; c++){
+		if (next() != *c){
+			set_error("Invalid literal");
+			return false;
+		}
+	}
+
+	r_value = value;
+	return true;
+}
+
+JsonStreamReader::Token JsonStreamReader::get_token() const{
+	return current_token;
+}
+
+String JsonStreamReader::get_key() const{
+	return current_key;
+}
+
+Variant JsonStreamReader::get_value() const{
+	return current_value;
+}
+
+// Number of containers enclosing the reader position.
+int32_t JsonStreamReader::get_depth() const{
+	return containers.size();
+}
+
+// Build the value at the current token, consuming a whole container if one starts here.
+Variant JsonStreamReader::read_value(){
+	switch (current_token){
+		case TOKEN_VALUE:
+			return current_value;
+		case TOKEN_OBJECT_BEGIN: {
+			Dictionary object;
+			while (true){
+				Token token = read_next();
+				if (token == TOKEN_ERROR){
+					return Variant();
+				}
+				if (token == TOKEN_OBJECT_END){
+					break;
+				}
+
+				String key = current_key;
+				object[key] = read_value();
+			}
+			return object;
+		}
+		case TOKEN_ARRAY_BEGIN: {
+			Array array;
+			while (true){
+				Token token = read_next();
+				if (token == TOKEN_ERROR){
+					return Variant();
+				}
+				if (token == TOKEN_ARRAY_END){
+					break;
+				}
+
+				array.push_back(read_value());
+			}
+			return array;
+		}
+		default:
+			return Variant();
+	}
+}
+
+// Consume the container starting at the current token without building it.
+Error JsonStreamReader::skip_value(){
+	if (current_token != TOKEN_OBJECT_BEGIN && current_token != TOKEN_ARRAY_BEGIN){
+		return error;
+	}
+
+	uint32_t target_depth = containers.size() - 1;
+
+	skipping = true;
+	while (containers.size() > target_depth){
+		if (read_next() == TOKEN_ERROR){
+			break;
+		}
+	}
+	skipping = false;
+
+	return error;
+}
+
+// Check the rest of the document without building any values.
+Error JsonStreamReader::validate(){
+	skipping = true;
+	while (true){
+		Token token = read_next();
+		if (token == TOKEN_END || token == TOKEN_ERROR){
+			break;
+		}
+	}
+	skipping = false;
+
+	return error;
+}
+
+// Build only the value at key_path, e.g. ["units", "0", "stats"]; array elements are addressed by index.
+// Siblings along the way are skipped. Returns null when the path does not exist.
+Variant JsonStreamReader::extract(PackedStringArray key_path){
+	Token token = current_token == TOKEN_NONE ? read_next() : current_token;
+
+	for (int64_t segment_index = 0; segment_index < key_path.size(); segment_index++){
+		const String segment = key_path[segment_index];
+		bool found = false;
+
+		if (token == TOKEN_OBJECT_BEGIN){
+			while (true){
+				token = read_next();
+				if (token == TOKEN_OBJECT_END || token == TOKEN_ERROR){
+					break;
+				}
+				if (current_key == segment){
+					found = true;
+					break;
+				}
+				if ((token == TOKEN_OBJECT_BEGIN || token == TOKEN_ARRAY_BEGIN) && skip_value() != OK){
+					break;
+				}
+			}
+		}else if (token == TOKEN_ARRAY_BEGIN && segment.is_valid_int()){
+			int64_t index = segment.to_int();
+			for (int64_t i = 0; ; i++){
+				token = read_next();
+				if (token == TOKEN_ARRAY_END || token == TOKEN_ERROR){
+					break;
+				}
+				if (i == index){
+					found = true;
+					break;
+				}
+				if ((token == TOKEN_OBJECT_BEGIN || token == TOKEN_ARRAY_BEGIN) && skip_value() != OK){
+					break;
+				}
+			}
+		}
+
+		if (!found){
+			return Variant();
+		}
+	}
+
+	return read_value();
+}
+
+Error JsonStreamReader::get_error() const{
+	return error;
+}
+
+String JsonStreamReader::get_error_message() const{
+	return error_message;
+}
+
+int32_t JsonStreamReader::get_error_line() const{
+	return line;
+}
+
+// Check that a file holds valid JSON while reading it in fixed size chunks.
+Error JsonStreamReader::validate_file(String file_path){
+	Ref<JsonStreamReader> reader = memnew(JsonStreamReader);
+
+	Error err = reader->open(file_path);
+	if (err == OK){
+		err = reader->validate();
+	}
+
+	if (err != OK){
+		EAM_LOG_ERROR("JSON Parse Error: ", reader->get_error_message(), " in ", file_path, " at line ", reader->get_error_line());
+	}
+	return err;
+}
+
+// Read a single sub-tree of a file, see extract().
+Variant JsonStreamReader::extract_from_file(String file_path, PackedStringArray key_path){
+	Ref<JsonStreamReader> reader = memnew(JsonStreamReader);
+	if (reader->open(file_path) != OK){
+		EAM_LOG_ERROR("Failed to read file: " + file_path);
+		return Variant();
+	}
+
+	return reader->extract(key_path);
+}
@@ -0,0 +1,184 @@
+#include "load_latency_stats.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+static inline int32_t _get_bucket(uint64_t elapsed_usec){
+	int32_t bucket = 0;
+	while (elapsed_usec > 1 && bucket < LoadLatencyStats::BUCKET_COUNT - 1){
+		elapsed_usec >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+void LoadLatencyStats::_bind_methods() {}
+
+LoadLatencyStats::LoadLatencyStats():slot_mutex{memnew(godot::Mutex)} {
+	reset();
+}
+
+LoadLatencyStats::~LoadLatencyStats() {}
+
+String LoadLatencyStats::get_stage_name(Stage stage){
+	switch (stage){
+	case STAGE_RESOLVE:
+		return "resolve";
+	case STAGE_CACHE:
+		return "cache";
+	case STAGE_IMPORTED:
+		return "imported";
+	case STAGE_DECODE:
+		return "decode";
+	case STAGE_FINALIZE:
+		return "finalize";
+	case STAGE_TOTAL:
+		return "total";
+	default:
+		return "";
+	}
+}
+
+// Slots are only appended and their name is written before the count is published.
+int32_t LoadLatencyStats::find_slot(const String &content_type) const{
+	int32_t count = slot_count.load(std::memory_order_acquire);
+	for (int32_t i = 0; i < count; i++){
+		if (slots[i].content_type == content_type){
+			return i;
+		}
+	}
+	return -1;
+}
+
+int32_t LoadLatencyStats::add_slot(const String &content_type){
+	MutexLock lock{**slot_mutex};
+
+	int32_t slot = find_slot(content_type);
+	if (slot >= 0){
+		return slot;
+	}
+
+	int32_t count = slot_count.load(std::memory_order_relaxed);
+	if (count >= MAX_CONTENT_TYPES){
+		return -1;
+	}
+
+	slots[count].content_type = content_type;
+	slot_count.store(count + 1, std::memory_order_release);
+	return count;
+}
+
+// Add one sample; returns true when this is the first sample of a new content type.
+bool LoadLatencyStats::record(const String &content_type, Stage stage, uint64_t elapsed_usec){
+	bool added = false;
+
+	int32_t slot = find_slot(content_type);
+	if (slot < 0){
+		slot = add_slot(content_type);
+		if (slot < 0){
+			return false;
+		}
+		added = true;
+	}
+
+	StageHistogram &histogram = slots[slot].stages[stage];
+	histogram.buckets[_get_bucket(elapsed_usec)].fetch_add(1, std::memory_order_relaxed);
+	histogram.count.fetch_add(1, std::memory_order_relaxed);
+	histogram.total_usec.fetch_add(elapsed_usec, std::memory_order_relaxed);
+
+	uint64_t max_usec = histogram.max_usec.load(std::memory_order_relaxed);
+	while (elapsed_usec > max_usec && !histogram.max_usec.compare_exchange_weak(max_usec, elapsed_usec, std::memory_order_relaxed)){
+	}
+
+	return added;
+}
+
+// Upper bound of the bucket containing the given percentile, in milliseconds.
+double LoadLatencyStats::get_percentile_ms(const StageHistogram &histogram, double percentile){
+	uint64_t count = histogram.count.load(std::memory_order_relaxed);
+	if (count == 0){
+		return 0.0;
+	}
+
+	uint64_t target = MAX((uint64_t)(count * percentile), (uint64_t)1);
+	uint64_t seen = 0;
+	for (int32_t i = 0; i < BUCKET_COUNT; i++){
+		seen += histogram.buckets[i].load(std::memory_order_relaxed);
+		if (seen >= target){
+			return (double)((uint64_t)1 << (i + 1)) / 1000.0;
+		}
+	}
+
+	return histogram.max_usec.load(std::memory_order_relaxed) / 1000.0;
+}
+
+// Average in milliseconds for percentile 0, otherwise the given percentile.
+double LoadLatencyStats::get_monitor_value(const String &content_type, Stage stage, double percentile) const{
+	int32_t slot = find_slot(content_type);
+	if (slot < 0){
+		return 0.0;
+	}
+
+	const StageHistogram &histogram = slots[slot].stages[stage];
+	if (percentile > 0.0){
+		return get_percentile_ms(histogram, percentile);
+	}
+
+	uint64_t count = histogram.count.load(std::memory_order_relaxed);
+	if (count == 0){
+		return 0.0;
+	}
+	return histogram.total_usec.load(std::memory_order_relaxed) / 1000.0 / count;
+}
+
+// Snapshot of all histograms: {content_type: {stage: {count, avg_ms, p50_ms, p95_ms, p99_ms, max_ms, buckets}}}.
+Dictionary LoadLatencyStats::get_stats() const{
+	Dictionary stats;
+
+	int32_t count = slot_count.load(std::memory_order_acquire);
+	for (int32_t slot = 0; slot < count; slot++){
+		Dictionary content_type_stats;
+
+		for (int32_t stage = 0; stage < STAGE_MAX; stage++){
+			const StageHistogram &histogram = slots[slot].stages[stage];
+			uint64_t sample_count = histogram.count.load(std::memory_order_relaxed);
+			if (sample_count == 0){
+				continue;
+			}
+
+			PackedInt64Array buckets;
+			for (int32_t i = 0; i < BUCKET_COUNT; i++){
+				buckets.push_back(histogram.buckets[i].load(std::memory_order_relaxed));
+			}
+
+			Dictionary stage_stats;
+			stage_stats["count"] = sample_count;
+			stage_stats["avg_ms"] = histogram.total_usec.load(std::memory_order_relaxed) / 1000.0 / sample_count;
+			stage_stats["p50_ms"] = get_percentile_ms(histogram, 0.5);
+			stage_stats["p95_ms"] = get_percentile_ms(histogram, 0.95);
+			stage_stats["p99_ms"] = get_percentile_ms(histogram, 0.99);
+			stage_stats["max_ms"] = histogram.max_usec.load(std::memory_order_relaxed) / 1000.0;
+			stage_stats["buckets"] = buckets;
+			content_type_stats[get_stage_name((Stage)stage)] = stage_stats;
+		}
+
+		stats[slots[slot].content_type] = content_type_stats;
+	}
+
+	return stats;
+}
+
+// Zero all samples; content type slots are kept.
+void LoadLatencyStats::reset(){
+	for (ContentTypeSlot &slot : slots){
+		for (StageHistogram &histogram : slot.stages){
+			for (std::atomic<uint64_t> &bucket : histogram.buckets){
+				bucket.store(0, std::memory_order_relaxed);
+			}
+			histogram.count.store(0, std::memory_order_relaxed);
+			histogram.total_usec.store(0, std::memory_order_relaxed);
+			histogram.max_usec.store(0, std::memory_order_relaxed);
+		}
+	}
+}
@@ -0,0 +1,271 @@
+#include "model_content_loader.hpp"
+#include "asset_logger.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/gltf_document.hpp>
+#include <godot_cpp/classes/gltf_state.hpp>
+#include <godot_cpp/classes/hashing_context.hpp>
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/classes/resource_saver.hpp>
+
+#include "data_cache_manager.hpp"
+#include "json_stream_reader.hpp"
+
+using namespace godot;
+
+// Relative uris of the buffers and images a .gltf file references; empty for .glb.
+static inline PackedStringArray _get_gltf_references(const String &p_path){
+	PackedStringArray uris;
+	if (p_path.get_extension().to_lower() != "gltf"){
+		return uris;
+	}
+
+	const char *sections[] = { "buffers", "images" };
+	for (const char *section : sections){
+		PackedStringArray key_path;
+		key_path.push_back(section);
+
+		Variant extracted = JsonStreamReader::extract_from_file(p_path, key_path);
+		if (extracted.get_type() != Variant::ARRAY){
+			continue;
+		}
+
+		Array references = extracted;
+		for (int64_t i = 0; i < references.size(); i++){
+			Dictionary reference = references[i];
+			String uri = reference.get("uri", "");
+			if (uri != "" && !uri.begins_with("data:")){
+				uris.push_back(uri);
+			}
+		}
+	}
+
+	return uris;
+}
+
+// Size and modification time of a file, or -1 when it cannot be opened.
+static inline String _get_file_stamp(const String &file_path){
+	auto file = FileAccess::open(file_path, FileAccess::READ);
+	int64_t file_size = file == nullptr ? -1 : file->get_length();
+
+	return String::num_int64(file_size) + ":" + String::num_uint64(FileAccess::get_modified_time(file_path));
+}
+
+void ModelContentLoader::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_scene_cache_enabled", "enabled"), &ModelContentLoader::set_scene_cache_enabled);
+	ClassDB::bind_method(D_METHOD("get_scene_cache_enabled"), &ModelContentLoader::get_scene_cache_enabled);
+	ClassDB::bind_method(D_METHOD("clear_scene_cache"), &ModelContentLoader::clear_scene_cache);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "scene_cache_enabled"), "set_scene_cache_enabled", "get_scene_cache_enabled");
+}
+
+ModelContentLoader::ModelContentLoader() {}
+
+ModelContentLoader::~ModelContentLoader() {}
+
+String ModelContentLoader::get_loader_name() const {
+	return "models";
+}
+
+String ModelContentLoader::get_resource_type() const {
+	return "PackedScene";
+}
+
+PackedStringArray ModelContentLoader::get_recognized_extensions() const {
+	PackedStringArray extensions;
+	extensions.push_back("gltf");
+	extensions.push_back("glb");
+	return extensions;
+}
+
+bool ModelContentLoader::is_thread_safe() const {
+	return true;
+}
+
+DynamicContentLoader::LoadThread ModelContentLoader::get_preferred_thread() const {
+	return LOAD_THREAD_WORKER;
+}
+
+DynamicContentLoader::CachePolicy ModelContentLoader::get_cache_policy() const {
+	return CACHE_POLICY_SHARED;
+}
+
+// Load the cached scene of a model, converting and caching the glTF file on a miss.
+Variant ModelContentLoader::decode_from_path(const String &p_path) const {
+	String entry_path = "";
+	if (scene_cache_enabled){
+		String source_hash = get_cached_source_hash(p_path);
+		if (source_hash != ""){
+			entry_path = get_entry_path(source_hash);
+		}
+	}
+
+	if (entry_path != "" && FileAccess::file_exists(entry_path)){
+		Ref<PackedScene> cached_scene = ResourceLoader::get_singleton()->load(entry_path, "PackedScene", ResourceLoader::CACHE_MODE_IGNORE);
+		if (cached_scene.is_valid()){
+			return cached_scene;
+		}
+
+		EAM_LOG_WARNING("Ignoring unreadable model cache entry: " + entry_path);
+	}
+
+	Ref<PackedScene> scene = convert_gltf(p_path);
+	if (scene.is_null()){
+		EAM_LOG_ERROR("error loading dynamic model: '" + p_path + "'");
+		return FAILED;
+	}
+
+	if (entry_path != ""){
+		store_scene(entry_path, scene);
+	}
+
+	return scene;
+}
+
+// Parse a glTF file and pack the generated node tree.
+Ref<PackedScene> ModelContentLoader::convert_gltf(const String &p_path) const{
+	Ref<GLTFDocument> document{};
+	document.instantiate();
+	Ref<GLTFState> state{};
+	state.instantiate();
+
+	Error err = document->append_from_file(p_path, state, 0, p_path.get_base_dir());
+	if (err != OK){
+		EAM_LOG_ERROR("Failed to parse glTF file: '" + p_path + "'");
+		return nullptr;
+	}
+
+	Node *root = document->generate_scene(state);
+	if (root == nullptr){
+		EAM_LOG_ERROR("Failed to generate scene from glTF file: '" + p_path + "'");
+		return nullptr;
+	}
+
+	Ref<PackedScene> scene{};
+	scene.instantiate();
+	err = scene->pack(root);
+	memdelete(root);
+
+	if (err != OK){
+		EAM_LOG_ERROR("Failed to pack scene from glTF file: '" + p_path + "'");
+		return nullptr;
+	}
+
+	return scene;
+}
+
+// Path, sizes and modification times of the model file and the files it references.
+String ModelContentLoader::get_source_stamp(const String &p_path) const{
+	String stamp = "model:" + p_path + ":" + _get_file_stamp(p_path);
+
+	PackedStringArray uris = _get_gltf_references(p_path);
+	for (int64_t i = 0; i < uris.size(); i++){
+		stamp += "\n" + uris[i] + ":" + _get_file_stamp(p_path.get_base_dir().path_join(uris[i].uri_decode()));
+	}
+
+	return stamp;
+}
+
+// Hash of the model file and, for .gltf, the buffers and images it references.
+String ModelContentLoader::get_source_hash(const String &p_path) const{
+	PackedByteArray source = FileAccess::get_file_as_bytes(p_path);
+	if (source.is_empty()){
+		return "";
+	}
+
+	Ref<HashingContext> ctx = memnew(HashingContext);
+	ctx->start(HashingContext::HashType::HASH_SHA256);
+	ctx->update(source);
+
+	PackedStringArray uris = _get_gltf_references(p_path);
+	for (int64_t i = 0; i < uris.size(); i++){
+		ctx->update(uris[i].to_utf8_buffer());
+		ctx->update(FileAccess::get_file_as_bytes(p_path.get_base_dir().path_join(uris[i].uri_decode())));
+	}
+
+	return ctx->finish().hex_encode();
+}
+
+// Content hash for the source's current stamp; the files are only read and hashed when the stamp is new.
+String ModelContentLoader::get_cached_source_hash(const String &p_path) const{
+	String stamp_key = DataCacheManager::compute_string_hash(get_source_stamp(p_path), DataCacheManager::HASH_ALGORITHM_SHA256);
+	String key_path = cache_dir + "/" + stamp_key + ".key";
+
+	if (FileAccess::file_exists(key_path)){
+		String source_hash = FileAccess::get_file_as_string(key_path).strip_edges();
+		if (source_hash != ""){
+			return source_hash;
+		}
+	}
+
+	String source_hash = get_source_hash(p_path);
+	if (source_hash == ""){
+		return "";
+	}
+
+	DirAccess::make_dir_recursive_absolute(cache_dir);
+
+	String temp_path = key_path + ".tmp" + String::num_uint64(OS::get_singleton()->get_thread_caller_id());
+	auto file = FileAccess::open(temp_path, FileAccess::WRITE);
+	if (file == nullptr){
+		return source_hash;
+	}
+
+	bool stored = file->store_string(source_hash) && file->get_error() == OK;
+	file->close();
+
+	if (!stored || DirAccess::rename_absolute(temp_path, key_path) != OK){
+		DirAccess::remove_absolute(temp_path);
+	}
+
+	return source_hash;
+}
+
+String ModelContentLoader::get_entry_path(const String &source_hash) const{
+	return cache_dir + "/" + source_hash + ".scn";
+}
+
+// Save a converted scene through a temporary file so readers never see partial entries.
+void ModelContentLoader::store_scene(const String &entry_path, const Ref<PackedScene> &scene) const{
+	DirAccess::make_dir_recursive_absolute(cache_dir);
+
+	String temp_path = entry_path.get_basename() + ".tmp" + String::num_uint64(OS::get_singleton()->get_thread_caller_id()) + ".scn";
+	Error err = ResourceSaver::get_singleton()->save(scene, temp_path, ResourceSaver::FLAG_COMPRESS | ResourceSaver::FLAG_BUNDLE_RESOURCES);
+	if (err != OK){
+		EAM_LOG_ERROR("Failed to save model cache entry: " + entry_path);
+		DirAccess::remove_absolute(temp_path);
+		return;
+	}
+
+	if (DirAccess::rename_absolute(temp_path, entry_path) != OK){
+		DirAccess::remove_absolute(temp_path);
+	}
+}
+
+void ModelContentLoader::set_scene_cache_enabled(bool p_enabled){
+	scene_cache_enabled = p_enabled;
+}
+
+bool ModelContentLoader::get_scene_cache_enabled() const{
+	return scene_cache_enabled;
+}
+
+// Remove all cached model scenes.
+void ModelContentLoader::clear_scene_cache() const{
+	auto dir = DirAccess::open(cache_dir);
+	if (dir == nullptr){
+		return;
+	}
+
+	dir->list_dir_begin();
+	String entry = "";
+	while ((entry = dir->get_next()) != ""){
+		if (!dir->current_is_dir()){
+			dir->remove(entry);
+		}
+	}
+}
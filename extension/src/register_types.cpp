@@ -1,10 +1,27 @@
 #include "register_types.hpp"
 
 #include "identifier.hpp"
+#include "asset_logger.hpp"
 #include "dynamic_asset_indexer.hpp"
 #include "dynmaic_prefix_handler.hpp"
 #include "data_cache_manager.hpp"
+#include "data_cache_store.hpp"
 #include "entity_template_manager.hpp"
+#include "dynamic_content_loader.hpp"
+#include "content_loader_registry.hpp"
+#include "texture_content_loader.hpp"
+#include "font_content_loader.hpp"
+#include "audio_content_loader.hpp"
+#include "model_content_loader.hpp"
+#include "json_content_loader.hpp"
+#include "json_stream_reader.hpp"
+#include "dynamic_resource_cache.hpp"
+#include "dynamic_load_batch.hpp"
+#include "image_decode_limiter.hpp"
+#include "texture_cache.hpp"
+#include "texture_atlas_builder.hpp"
+#include "resource_residency_manager.hpp"
+#include "load_latency_stats.hpp"
 
 #include <gdextension_interface.h>
 #include <godot_cpp/core/defs.hpp>
@@ -17,9 +34,26 @@ using namespace godot;
 // Register all extension classes with Godot.
 void register_external_asset_manager_types() {
 	ClassDB::register_class<Identifier>();
+	ClassDB::register_class<AssetLogger>();
 	ClassDB::register_class<DynamicAssetIndexer>();
 	ClassDB::register_class<DataCacheManager>();
 	ClassDB::register_class<EntityTemplateManager>();
+	ClassDB::register_class<DynamicContentLoader>();
+	ClassDB::register_class<TextureContentLoader>();
+	ClassDB::register_class<FontContentLoader>();
+	ClassDB::register_class<AudioContentLoader>();
+	ClassDB::register_class<ModelContentLoader>();
+	ClassDB::register_class<JsonContentLoader>();
+	ClassDB::register_class<ContentLoaderRegistry>();
+	ClassDB::register_class<JsonStreamReader>();
+	ClassDB::register_internal_class<DynamicResourceCache>();
+	ClassDB::register_internal_class<DynamicLoadBatch>();
+	ClassDB::register_internal_class<ImageDecodeLimiter>();
+	ClassDB::register_internal_class<TextureCache>();
+	ClassDB::register_internal_class<TextureAtlasBuilder>();
+	ClassDB::register_internal_class<ResourceResidencyManager>();
+	ClassDB::register_internal_class<LoadLatencyStats>();
+	ClassDB::register_internal_class<DataCacheStore>();
 	ClassDB::register_class<DynmaicPrefixHandler>(true);
 }
 
@@ -28,12 +62,18 @@ void initialize_external_asset_manager_module(ModuleInitializationLevel p_level)
 	switch (p_level) {
 	case MODULE_INITIALIZATION_LEVEL_CORE:
 		register_external_asset_manager_types();
+		AssetLogger::initialize_recent_entries();
 		return;
 	case MODULE_INITIALIZATION_LEVEL_SCENE:
 		// Register singletons with engine.
 		Engine::get_singleton()->register_singleton("AssetIndexer", DynamicAssetIndexer::get_singleton().ptr());
 		Engine::get_singleton()->register_singleton("DataCache", DataCacheManager::get_singleton().ptr());
 		Engine::get_singleton()->register_singleton("EntityTemplates", EntityTemplateManager::get_singleton().ptr());
+		Engine::get_singleton()->register_singleton("ContentLoaders", ContentLoaderRegistry::get_singleton().ptr());
+		Engine::get_singleton()->register_singleton("DynamicLoader", DynmaicPrefixHandler::get_singleton().ptr());
+
+		// Register native content loaders.
+		ContentLoaderRegistry::get_singleton()->register_default_loaders();
 
 		// Index assets at startup.
 		DynamicAssetIndexer::get_singleton()->index_files();
@@ -52,17 +92,31 @@ void uninitialize_external_asset_manager_module(ModuleInitializationLevel p_leve
 		return;
 	}
 
+	// Drain background loads first; they still use the indexer and data cache.
+	Engine::get_singleton()->unregister_singleton("DynamicLoader");
+	DynmaicPrefixHandler::get_singleton()->release_all_batches();
+	ContentLoaderRegistry::get_singleton()->wait_for_background_tasks();
+	DynmaicPrefixHandler::get_singleton()->release_resident_resources();
+	DynmaicPrefixHandler::get_singleton()->release_latency_monitors();
+	ResourceLoader::get_singleton()->remove_resource_format_loader(DynmaicPrefixHandler::get_singleton());
+	DynmaicPrefixHandler::destory_singleton();
+
 	Engine::get_singleton()->unregister_singleton("AssetIndexer");
 	DynamicAssetIndexer::destory_singleton();
 
 	Engine::get_singleton()->unregister_singleton("DataCache");
+	DataCacheManager::get_singleton()->flush();
+	DataCacheManager::get_singleton()->save_manifest();
 	DataCacheManager::destory_singleton();
 
 	Engine::get_singleton()->unregister_singleton("EntityTemplates");
 	EntityTemplateManager::destory_singleton();
 
-	ResourceLoader::get_singleton()->remove_resource_format_loader(DynmaicPrefixHandler::get_singleton());
-	DynmaicPrefixHandler::destory_singleton();
+	Engine::get_singleton()->unregister_singleton("ContentLoaders");
+	ContentLoaderRegistry::destory_singleton();
+
+	AssetLogger::release_recent_entries();
+	Identifier::release_content_types();
 }
 
 
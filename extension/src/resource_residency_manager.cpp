@@ -0,0 +1,160 @@
+#include "resource_residency_manager.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+void ResourceResidencyManager::_bind_methods() {}
+
+ResourceResidencyManager::ResourceResidencyManager():residency_mutex{memnew(godot::Mutex)} {}
+
+ResourceResidencyManager::~ResourceResidencyManager() {}
+
+// Set the memory budget for a content type; 0 disables residency for it.
+void ResourceResidencyManager::set_budget(String content_type, int64_t budget_bytes){
+	MutexLock lock{**residency_mutex};
+
+	ContentTypeState &state = content_types[content_type];
+	state.budget = MAX(budget_bytes, (int64_t)0);
+	_evict_to_budget(state);
+}
+
+int64_t ResourceResidencyManager::get_budget(String content_type){
+	MutexLock lock{**residency_mutex};
+	if (!content_types.has(content_type)){
+		return 0;
+	}
+
+	return content_types[content_type].budget;
+}
+
+bool ResourceResidencyManager::has_budget(String content_type){
+	return get_budget(content_type) > 0;
+}
+
+// Hold a freshly loaded resource and evict older ones if the budget is exceeded.
+void ResourceResidencyManager::track_resource(String content_type, Ref<Resource> resource, int64_t size_bytes){
+	if (resource.is_null()){
+		return;
+	}
+
+	MutexLock lock{**residency_mutex};
+
+	ContentTypeState &state = content_types[content_type];
+	if (state.budget <= 0){
+		return;
+	}
+
+	uint64_t resource_id = resource->get_instance_id();
+	_remove_entry(resource_id);
+
+	ResidentEntry entry{};
+	entry.resource = resource;
+	entry.content_type = content_type;
+	entry.size = MAX(size_bytes, (int64_t)0);
+	entry.lru_element = state.lru.push_front(resource_id);
+
+	entries[resource_id] = entry;
+	state.resident_bytes += entry.size;
+	state.misses++;
+
+	_evict_to_budget(state);
+}
+
+// Mark a resident resource as used.
+void ResourceResidencyManager::touch_resource(Ref<Resource> resource){
+	if (resource.is_null()){
+		return;
+	}
+
+	MutexLock lock{**residency_mutex};
+
+	auto entry = entries.find(resource->get_instance_id());
+	if (entry == entries.end()){
+		return;
+	}
+
+	ContentTypeState &state = content_types[entry->value.content_type];
+	state.lru.move_to_front(entry->value.lru_element);
+	state.hits++;
+}
+
+// Evict unreferenced resources of every content type down to their budgets.
+void ResourceResidencyManager::trim(){
+	MutexLock lock{**residency_mutex};
+	for (auto &[key, state] : content_types){
+		_evict_to_budget(state);
+	}
+}
+
+// Release every resident resource.
+void ResourceResidencyManager::clear(){
+	MutexLock lock{**residency_mutex};
+	entries.clear();
+	for (auto &[key, state] : content_types){
+		state.lru.clear();
+		state.resident_bytes = 0;
+	}
+}
+
+// Residency usage per content type, for tuning budgets.
+Dictionary ResourceResidencyManager::get_stats(){
+	MutexLock lock{**residency_mutex};
+
+	Dictionary stats;
+	for (const auto &[key, state] : content_types){
+		Dictionary type_stats;
+		type_stats["budget"] = state.budget;
+		type_stats["resident_bytes"] = state.resident_bytes;
+		type_stats["resident_count"] = state.lru.size();
+		type_stats["hits"] = state.hits;
+		type_stats["misses"] = state.misses;
+		type_stats["evictions"] = state.evictions;
+		stats[key] = type_stats;
+	}
+	return stats;
+}
+
+// Walk from least recently used and drop entries only this manager still references.
+// Entries still referenced elsewhere are in use, so they move to the front instead.
+// Caller must hold residency_mutex.
+void ResourceResidencyManager::_evict_to_budget(ContentTypeState &state){
+	if (state.resident_bytes <= state.budget){
+		return;
+	}
+
+	List<uint64_t> in_use;
+	List<uint64_t>::Element *element = state.lru.back();
+	while (element != nullptr && state.resident_bytes > state.budget){
+		List<uint64_t>::Element *previous = element->prev();
+
+		uint64_t resource_id = element->get();
+		ResidentEntry &entry = entries[resource_id];
+		if (entry.resource->get_reference_count() <= 1){
+			state.evictions++;
+			_remove_entry(resource_id);
+		}else{
+			in_use.push_front(resource_id);
+		}
+
+		element = previous;
+	}
+
+	// Keep the in-use entries in their relative order ahead of the rest.
+	for (List<uint64_t>::Element *used = in_use.back(); used != nullptr; used = used->prev()){
+		state.lru.move_to_front(entries[used->get()].lru_element);
+	}
+}
+
+// Caller must hold residency_mutex.
+void ResourceResidencyManager::_remove_entry(uint64_t resource_id){
+	auto entry = entries.find(resource_id);
+	if (entry == entries.end()){
+		return;
+	}
+
+	ContentTypeState &state = content_types[entry->value.content_type];
+	state.resident_bytes -= entry->value.size;
+	state.lru.erase(entry->value.lru_element);
+	entries.remove(entry);
+}
@@ -0,0 +1,324 @@
+#include "texture_atlas_builder.hpp"
+#include "asset_logger.hpp"
+#include "data_cache_manager.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
+
+using namespace godot;
+
+// Bump when the packing changes so old layouts are rebuilt.
+static constexpr int32_t ATLAS_LAYOUT_VERSION = 1;
+// Gap between packed images so filtering does not bleed neighbours into each other.
+static constexpr int32_t ATLAS_PADDING = 2;
+
+void TextureAtlasBuilder::_bind_methods() {}
+
+TextureAtlasBuilder::TextureAtlasBuilder():atlas_mutex{memnew(godot::Mutex)} {}
+
+TextureAtlasBuilder::~TextureAtlasBuilder() {}
+
+void TextureAtlasBuilder::setup(const Ref<ImageDecodeLimiter> &p_decode_limiter, const Ref<TextureCache> &p_texture_cache, const PackedStringArray &p_image_extensions){
+	decode_limiter = p_decode_limiter;
+	texture_cache = p_texture_cache;
+	image_extensions = p_image_extensions;
+}
+
+// Width and height of each atlas page; atlases packed with the old size are dropped.
+void TextureAtlasBuilder::set_page_size(int32_t p_page_size){
+	page_size = MAX(p_page_size, (int32_t)64);
+	clear();
+}
+
+int32_t TextureAtlasBuilder::get_page_size() const{
+	return page_size;
+}
+
+// Images with a larger edge are left out of the atlas and load as their own texture.
+void TextureAtlasBuilder::set_max_image_size(int32_t p_max_image_size){
+	max_image_size = MAX(p_max_image_size, (int32_t)1);
+	clear();
+}
+
+int32_t TextureAtlasBuilder::get_max_image_size() const{
+	return max_image_size;
+}
+
+// Region of the atlas holding an image file; null when the file was not packed.
+// The first request for a directory packs all of its images.
+Ref<AtlasTexture> TextureAtlasBuilder::get_region(const String &file_path){
+	bool built = false;
+	Ref<AtlasTexture> texture = find_region(file_path, built);
+	if (built){
+		return texture;
+	}
+
+	String dir_path = file_path.get_base_dir();
+	Ref<godot::Mutex> build_mutex{};
+	{
+		MutexLock lock{**atlas_mutex};
+		if (!build_mutexes.has(dir_path)){
+			build_mutexes[dir_path] = Ref<godot::Mutex>(memnew(godot::Mutex));
+		}
+		build_mutex = build_mutexes[dir_path];
+	}
+
+	// Requests for the same directory wait here while it is packed; others go on.
+	MutexLock build_lock{**build_mutex};
+	texture = find_region(file_path, built);
+	if (built){
+		return texture;
+	}
+
+	DirectoryAtlas atlas = build_atlas(dir_path);
+	{
+		MutexLock lock{**atlas_mutex};
+		atlases[dir_path] = atlas;
+	}
+
+	return find_region(file_path, built);
+}
+
+// Look up a region in an already built atlas; r_built is false when the directory was not packed yet.
+Ref<AtlasTexture> TextureAtlasBuilder::find_region(const String &file_path, bool &r_built){
+	MutexLock lock{**atlas_mutex};
+
+	auto atlas = atlases.find(file_path.get_base_dir());
+	r_built = atlas != atlases.end();
+	if (!r_built){
+		return nullptr;
+	}
+
+	auto region = atlas->value.regions.find(file_path.get_file());
+	if (region == atlas->value.regions.end()){
+		return nullptr;
+	}
+
+	Ref<AtlasTexture> texture{};
+	texture.instantiate();
+	texture->set_atlas(atlas->value.pages[region->value.page]);
+	texture->set_region(Rect2(region->value.rect));
+	return texture;
+}
+
+// Forget all built atlases; their pages are freed once no region uses them.
+void TextureAtlasBuilder::clear(){
+	MutexLock lock{**atlas_mutex};
+	atlases.clear();
+	build_mutexes.clear();
+}
+
+PackedStringArray TextureAtlasBuilder::list_images(const String &dir_path) const{
+	PackedStringArray image_files;
+
+	auto dir = DirAccess::open(dir_path);
+	if (dir == nullptr){
+		return image_files;
+	}
+
+	dir->list_dir_begin();
+	String entry = "";
+	while ((entry = dir->get_next()) != ""){
+		if (!dir->current_is_dir() && image_extensions.has(entry.get_extension().to_lower())){
+			image_files.push_back(entry);
+		}
+	}
+
+	image_files.sort();
+	return image_files;
+}
+
+// Cache key over the names, sizes and modification times of the images and the packing settings.
+String TextureAtlasBuilder::get_directory_key(const String &dir_path, const PackedStringArray &image_files) const{
+	String stamp = "atlas:" + itos(ATLAS_LAYOUT_VERSION) + ":" + itos(page_size) + ":" + itos(max_image_size);
+	for (int64_t i = 0; i < image_files.size(); i++){
+		String file_path = dir_path.path_join(image_files[i]);
+
+		auto file = FileAccess::open(file_path, FileAccess::READ);
+		int64_t file_size = file == nullptr ? -1 : file->get_length();
+
+		stamp += "\n" + image_files[i] + ":" + String::num_int64(file_size) + ":" + String::num_uint64(FileAccess::get_modified_time(file_path));
+	}
+
+	return DataCacheManager::compute_string_hash(stamp, DataCacheManager::HASH_ALGORITHM_SHA256);
+}
+
+bool TextureAtlasBuilder::load_cached_atlas(const String &directory_key, DirectoryAtlas &r_atlas) const{
+	String layout_path = cache_dir + "/" + directory_key + ".atlas.json";
+	if (!FileAccess::file_exists(layout_path)){
+		return false;
+	}
+
+	Variant parsed = JSON::parse_string(FileAccess::get_file_as_string(layout_path));
+	if (parsed.get_type() != Variant::DICTIONARY){
+		EAM_LOG_WARNING("Ignoring unreadable atlas layout: " + layout_path);
+		return false;
+	}
+
+	Dictionary layout = parsed;
+	if (layout.get("pages", Variant()).get_type() != Variant::FLOAT || layout.get("regions", Variant()).get_type() != Variant::DICTIONARY){
+		EAM_LOG_WARNING("Ignoring incomplete atlas layout: " + layout_path);
+		return false;
+	}
+
+	int32_t page_count = layout["pages"];
+	Dictionary regions = layout["regions"];
+
+	for (int32_t page = 0; page < page_count; page++){
+		Ref<Image> page_image = texture_cache->load_image(directory_key, "atlas" + itos(page));
+		if (page_image.is_null()){
+			return false;
+		}
+		r_atlas.pages.push_back(ImageTexture::create_from_image(page_image));
+	}
+
+	Array file_names = regions.keys();
+	for (int64_t i = 0; i < file_names.size(); i++){
+		Array values = regions[file_names[i]];
+		if (values.size() != 5 || (int32_t)values[0] >= page_count){
+			return false;
+		}
+
+		AtlasRegion region{};
+		region.page = values[0];
+		region.rect = Rect2i((int32_t)values[1], (int32_t)values[2], (int32_t)values[3], (int32_t)values[4]);
+		r_atlas.regions[String(file_names[i])] = region;
+	}
+
+	return true;
+}
+
+void TextureAtlasBuilder::store_cached_atlas(const String &directory_key, const Vector<Ref<Image>> &pages, const HashMap<String, AtlasRegion> &regions) const{
+	for (int32_t page = 0; page < pages.size(); page++){
+		if (texture_cache->store_image(directory_key, "atlas" + itos(page), pages[page]) != OK){
+			return;
+		}
+	}
+
+	Dictionary region_map;
+	for (const auto &[file_name, region] : regions){
+		Array values;
+		values.push_back(region.page);
+		values.push_back(region.rect.position.x);
+		values.push_back(region.rect.position.y);
+		values.push_back(region.rect.size.x);
+		values.push_back(region.rect.size.y);
+		region_map[file_name] = values;
+	}
+
+	Dictionary layout;
+	layout["pages"] = pages.size();
+	layout["regions"] = region_map;
+
+	// Written after the pages, so a layout only exists once all of its pages do.
+	DirAccess::make_dir_recursive_absolute(cache_dir);
+	String layout_path = cache_dir + "/" + directory_key + ".atlas.json";
+	String temp_path = layout_path + ".tmp" + String::num_uint64(OS::get_singleton()->get_thread_caller_id());
+
+	auto file = FileAccess::open(temp_path, FileAccess::WRITE);
+	if (file == nullptr){
+		EAM_LOG_ERROR("Failed to write atlas layout for: " + directory_key);
+		return;
+	}
+	file->store_string(JSON::stringify(layout));
+	file->close();
+
+	if (DirAccess::rename_absolute(temp_path, layout_path) != OK){
+		EAM_LOG_ERROR("Failed to write atlas layout for: " + directory_key);
+		DirAccess::remove_absolute(temp_path);
+	}
+}
+
+// Shelf pack the small images of a directory, tallest first, into as many pages as needed.
+TextureAtlasBuilder::DirectoryAtlas TextureAtlasBuilder::build_atlas(const String &dir_path) const{
+	DirectoryAtlas atlas{};
+
+	PackedStringArray image_files = list_images(dir_path);
+	if (image_files.is_empty()){
+		return atlas;
+	}
+
+	String directory_key = get_directory_key(dir_path, image_files);
+	if (load_cached_atlas(directory_key, atlas)){
+		return atlas;
+	}
+	atlas = DirectoryAtlas();
+
+	struct PackEntry {
+		String file_name;
+		Ref<Image> image;
+	};
+
+	struct PackEntryHeightGreater {
+		bool operator()(const PackEntry &a, const PackEntry &b) const {
+			return a.image->get_height() > b.image->get_height();
+		}
+	};
+
+	// Images must also fit inside a page with padding on both sides.
+	int32_t fit_size = MIN(max_image_size, page_size - 2 * ATLAS_PADDING);
+
+	Vector<PackEntry> entries;
+	for (int64_t i = 0; i < image_files.size(); i++){
+		String file_path = dir_path.path_join(image_files[i]);
+
+		// Skip large images from their header alone when the format allows it.
+		Vector2i header_size = ImageDecodeLimiter::read_image_size(file_path);
+		if (header_size.x > fit_size || header_size.y > fit_size){
+			continue;
+		}
+
+		Ref<Image> image = decode_limiter->decode_image(file_path);
+		if (image.is_null() || image->is_compressed()){
+			continue;
+		}
+		if (image->get_width() > fit_size || image->get_height() > fit_size){
+			continue;
+		}
+
+		image->convert(Image::FORMAT_RGBA8);
+		entries.push_back({ image_files[i], image });
+	}
+
+	entries.sort_custom<PackEntryHeightGreater>();
+
+	Vector<Ref<Image>> pages;
+	Point2i cursor{ ATLAS_PADDING, ATLAS_PADDING };
+	int32_t shelf_height = 0;
+
+	for (const PackEntry &entry : entries){
+		Vector2i size = entry.image->get_size();
+
+		if (cursor.x + size.x + ATLAS_PADDING > page_size){
+			cursor = Point2i(ATLAS_PADDING, cursor.y + shelf_height + ATLAS_PADDING);
+			shelf_height = 0;
+		}
+		if (pages.is_empty() || cursor.y + size.y + ATLAS_PADDING > page_size){
+			pages.push_back(Image::create_empty(page_size, page_size, false, Image::FORMAT_RGBA8));
+			cursor = Point2i(ATLAS_PADDING, ATLAS_PADDING);
+			shelf_height = 0;
+		}
+
+		Ref<Image> page = pages[pages.size() - 1];
+		page->blit_rect(entry.image, Rect2i(Point2i(), size), cursor);
+
+		AtlasRegion region{};
+		region.page = pages.size() - 1;
+		region.rect = Rect2i(cursor, size);
+		atlas.regions[entry.file_name] = region;
+
+		cursor.x += size.x + ATLAS_PADDING;
+		shelf_height = MAX(shelf_height, size.y);
+	}
+
+	store_cached_atlas(directory_key, pages, atlas.regions);
+
+	for (const Ref<Image> &page : pages){
+		atlas.pages.push_back(ImageTexture::create_from_image(page));
+	}
+
+	EAM_LOG_INFO("Packed ", atlas.regions.size(), " images from '", dir_path, "' into ", pages.size(), " atlas pages.");
+	return atlas;
+}
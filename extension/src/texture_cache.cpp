@@ -0,0 +1,109 @@
+#include "texture_cache.hpp"
+#include "asset_logger.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/dir_access.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/os.hpp>
+
+using namespace godot;
+
+// "EAMT" in little endian.
+static constexpr uint32_t TEXTURE_CACHE_MAGIC = 0x544D4145;
+static constexpr uint32_t TEXTURE_CACHE_VERSION = 1;
+
+void TextureCache::_bind_methods() {}
+
+TextureCache::TextureCache() {}
+
+TextureCache::~TextureCache() {}
+
+String TextureCache::get_entry_path(const String &source_hash, const String &variant) const{
+	return cache_dir + "/" + source_hash + "." + variant + ".eamtex";
+}
+
+// Read a cached image; returns null when there is no valid entry.
+Ref<Image> TextureCache::load_image(const String &source_hash, const String &variant) const{
+	String entry_path = get_entry_path(source_hash, variant);
+	if (!FileAccess::file_exists(entry_path)){
+		return nullptr;
+	}
+
+	auto file = FileAccess::open(entry_path, FileAccess::READ);
+	if (file == nullptr){
+		return nullptr;
+	}
+
+	if (file->get_32() != TEXTURE_CACHE_MAGIC || file->get_32() != TEXTURE_CACHE_VERSION){
+		EAM_LOG_WARNING("Ignoring outdated texture cache entry: " + entry_path);
+		return nullptr;
+	}
+
+	int32_t width = file->get_32();
+	int32_t height = file->get_32();
+	auto format = static_cast<Image::Format>(file->get_32());
+	bool has_mipmaps = file->get_8() != 0;
+	uint64_t data_size = file->get_64();
+
+	PackedByteArray data = file->get_buffer(data_size);
+	file->close();
+
+	if ((uint64_t)data.size() != data_size){
+		EAM_LOG_WARNING("Truncated texture cache entry: " + entry_path);
+		return nullptr;
+	}
+
+	return Image::create_from_data(width, height, has_mipmaps, format, data);
+}
+
+// Write an image through a temporary file so readers never see partial entries.
+Error TextureCache::store_image(const String &source_hash, const String &variant, const Ref<Image> &image) const{
+	if (image.is_null() || image->is_empty()){
+		return ERR_INVALID_PARAMETER;
+	}
+
+	DirAccess::make_dir_recursive_absolute(cache_dir);
+
+	String entry_path = get_entry_path(source_hash, variant);
+	String temp_path = entry_path + ".tmp" + String::num_uint64(OS::get_singleton()->get_thread_caller_id());
+
+	auto file = FileAccess::open(temp_path, FileAccess::WRITE);
+	if (file == nullptr){
+		EAM_LOG_ERROR("Failed to open texture cache file for writing: " + temp_path);
+		return ERR_FILE_CANT_WRITE;
+	}
+
+	PackedByteArray data = image->get_data();
+
+	file->store_32(TEXTURE_CACHE_MAGIC);
+	file->store_32(TEXTURE_CACHE_VERSION);
+	file->store_32(image->get_width());
+	file->store_32(image->get_height());
+	file->store_32(image->get_format());
+	file->store_8(image->has_mipmaps() ? 1 : 0);
+	file->store_64(data.size());
+	file->store_buffer(data);
+	file->close();
+
+	Error err = DirAccess::rename_absolute(temp_path, entry_path);
+	if (err != OK){
+		DirAccess::remove_absolute(temp_path);
+	}
+	return err;
+}
+
+// Remove all cached texture entries.
+void TextureCache::clear() const{
+	auto dir = DirAccess::open(cache_dir);
+	if (dir == nullptr){
+		return;
+	}
+
+	dir->list_dir_begin();
+	String entry = "";
+	while ((entry = dir->get_next()) != ""){
+		if (!dir->current_is_dir()){
+			dir->remove(entry);
+		}
+	}
+}
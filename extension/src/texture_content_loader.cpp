@@ -0,0 +1,470 @@
+#include "texture_content_loader.hpp"
+#include "asset_logger.hpp"
+#include "data_cache_manager.hpp"
+
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/image.hpp>
+#include <godot_cpp/classes/image_texture.hpp>
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/rendering_server.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+
+using namespace godot;
+
+// Longest edge of the low resolution preview kept for streamed textures.
+static constexpr int32_t STREAM_PREVIEW_SIZE = 32;
+
+static inline int64_t _get_file_size(const String &p_path){
+	auto file = FileAccess::open(p_path, FileAccess::READ);
+	if (file == nullptr){
+		return -1;
+	}
+
+	return file->get_length();
+}
+
+void TextureContentLoader::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_decode_concurrency", "decode_concurrency"), &TextureContentLoader::set_decode_concurrency);
+	ClassDB::bind_method(D_METHOD("get_decode_concurrency"), &TextureContentLoader::get_decode_concurrency);
+
+	ClassDB::bind_method(D_METHOD("set_vram_compression", "vram_compression"), &TextureContentLoader::set_vram_compression);
+	ClassDB::bind_method(D_METHOD("get_vram_compression"), &TextureContentLoader::get_vram_compression);
+	ClassDB::bind_method(D_METHOD("set_generate_mipmaps", "generate_mipmaps"), &TextureContentLoader::set_generate_mipmaps);
+	ClassDB::bind_method(D_METHOD("get_generate_mipmaps"), &TextureContentLoader::get_generate_mipmaps);
+	ClassDB::bind_method(D_METHOD("set_streaming_enabled", "streaming_enabled"), &TextureContentLoader::set_streaming_enabled);
+	ClassDB::bind_method(D_METHOD("get_streaming_enabled"), &TextureContentLoader::get_streaming_enabled);
+	ClassDB::bind_method(D_METHOD("set_streaming_min_file_size", "streaming_min_file_size"), &TextureContentLoader::set_streaming_min_file_size);
+	ClassDB::bind_method(D_METHOD("get_streaming_min_file_size"), &TextureContentLoader::get_streaming_min_file_size);
+	ClassDB::bind_method(D_METHOD("set_atlas_directories", "atlas_directories"), &TextureContentLoader::set_atlas_directories);
+	ClassDB::bind_method(D_METHOD("get_atlas_directories"), &TextureContentLoader::get_atlas_directories);
+	ClassDB::bind_method(D_METHOD("set_atlas_page_size", "atlas_page_size"), &TextureContentLoader::set_atlas_page_size);
+	ClassDB::bind_method(D_METHOD("get_atlas_page_size"), &TextureContentLoader::get_atlas_page_size);
+	ClassDB::bind_method(D_METHOD("set_atlas_max_image_size", "atlas_max_image_size"), &TextureContentLoader::set_atlas_max_image_size);
+	ClassDB::bind_method(D_METHOD("get_atlas_max_image_size"), &TextureContentLoader::get_atlas_max_image_size);
+	ClassDB::bind_method(D_METHOD("clear_texture_cache"), &TextureContentLoader::clear_texture_cache);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "decode_concurrency"), "set_decode_concurrency", "get_decode_concurrency");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "vram_compression", PROPERTY_HINT_ENUM, "Disabled,Auto,BPTC,S3TC,ETC2"), "set_vram_compression", "get_vram_compression");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "generate_mipmaps"), "set_generate_mipmaps", "get_generate_mipmaps");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "streaming_enabled"), "set_streaming_enabled", "get_streaming_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "streaming_min_file_size", PROPERTY_HINT_NONE, "suffix:B"), "set_streaming_min_file_size", "get_streaming_min_file_size");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "atlas_directories"), "set_atlas_directories", "get_atlas_directories");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "atlas_page_size", PROPERTY_HINT_NONE, "suffix:px"), "set_atlas_page_size", "get_atlas_page_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "atlas_max_image_size", PROPERTY_HINT_NONE, "suffix:px"), "set_atlas_max_image_size", "get_atlas_max_image_size");
+
+	ADD_SIGNAL(MethodInfo("texture_streamed", PropertyInfo(Variant::OBJECT, "texture", PROPERTY_HINT_RESOURCE_TYPE, "ImageTexture"), PropertyInfo(Variant::STRING, "path")));
+
+	BIND_ENUM_CONSTANT(VRAM_COMPRESSION_DISABLED);
+	BIND_ENUM_CONSTANT(VRAM_COMPRESSION_AUTO);
+	BIND_ENUM_CONSTANT(VRAM_COMPRESSION_BPTC);
+	BIND_ENUM_CONSTANT(VRAM_COMPRESSION_S3TC);
+	BIND_ENUM_CONSTANT(VRAM_COMPRESSION_ETC2);
+}
+
+TextureContentLoader::TextureContentLoader():decode_limiter{memnew(ImageDecodeLimiter)}, texture_cache{memnew(TextureCache)}, atlas_builder{memnew(TextureAtlasBuilder)}, stream_mutex{memnew(godot::Mutex)} {
+	atlas_builder->setup(decode_limiter, texture_cache, get_recognized_extensions());
+}
+
+TextureContentLoader::~TextureContentLoader() {
+	reap_stream_tasks(true);
+}
+
+String TextureContentLoader::get_loader_name() const {
+	return "textures";
+}
+
+// ImageTexture, or AtlasTexture for images packed into an atlas.
+String TextureContentLoader::get_resource_type() const {
+	return "Texture2D";
+}
+
+PackedStringArray TextureContentLoader::get_recognized_extensions() const {
+	PackedStringArray extensions;
+	extensions.push_back("png");
+	extensions.push_back("jpg");
+	extensions.push_back("jpeg");
+	extensions.push_back("webp");
+	extensions.push_back("bmp");
+	extensions.push_back("tga");
+	extensions.push_back("svg");
+	extensions.push_back("ktx");
+	return extensions;
+}
+
+bool TextureContentLoader::is_thread_safe() const {
+	return true;
+}
+
+DynamicContentLoader::LoadThread TextureContentLoader::get_preferred_thread() const {
+	return LOAD_THREAD_WORKER;
+}
+
+DynamicContentLoader::CachePolicy TextureContentLoader::get_cache_policy() const {
+	return CACHE_POLICY_SHARED;
+}
+
+// Maximum number of images decoded at once; 0 uses one per processor.
+void TextureContentLoader::set_decode_concurrency(int32_t p_decode_concurrency){
+	decode_limiter->set_max_concurrency(p_decode_concurrency);
+}
+
+int32_t TextureContentLoader::get_decode_concurrency() const{
+	return decode_limiter->get_max_concurrency();
+}
+
+// Compress decoded images on the CPU and cache the result; disabled by default.
+void TextureContentLoader::set_vram_compression(VramCompression p_vram_compression){
+	vram_compression = p_vram_compression;
+}
+
+TextureContentLoader::VramCompression TextureContentLoader::get_vram_compression() const{
+	return vram_compression;
+}
+
+// Generate mip chains for loaded textures; disabled by default.
+// They are only persisted in the texture cache together with VRAM compression.
+void TextureContentLoader::set_generate_mipmaps(bool p_generate_mipmaps){
+	generate_mipmaps = p_generate_mipmaps;
+}
+
+bool TextureContentLoader::get_generate_mipmaps() const{
+	return generate_mipmaps;
+}
+
+// Return a low resolution placeholder for large files and stream the full image in the background.
+void TextureContentLoader::set_streaming_enabled(bool p_streaming_enabled){
+	streaming_enabled = p_streaming_enabled;
+}
+
+bool TextureContentLoader::get_streaming_enabled() const{
+	return streaming_enabled;
+}
+
+// Files smaller than this are always loaded synchronously.
+void TextureContentLoader::set_streaming_min_file_size(int64_t p_streaming_min_file_size){
+	streaming_min_file_size = p_streaming_min_file_size;
+}
+
+int64_t TextureContentLoader::get_streaming_min_file_size() const{
+	return streaming_min_file_size;
+}
+
+// Pack images up to atlas_max_image_size from directories with these names into shared atlas pages.
+// Their texture:// loads return AtlasTexture regions instead of separate textures.
+void TextureContentLoader::set_atlas_directories(PackedStringArray p_atlas_directories){
+	atlas_directories = p_atlas_directories;
+}
+
+PackedStringArray TextureContentLoader::get_atlas_directories() const{
+	return atlas_directories;
+}
+
+void TextureContentLoader::set_atlas_page_size(int32_t p_atlas_page_size){
+	atlas_builder->set_page_size(p_atlas_page_size);
+}
+
+int32_t TextureContentLoader::get_atlas_page_size() const{
+	return atlas_builder->get_page_size();
+}
+
+void TextureContentLoader::set_atlas_max_image_size(int32_t p_atlas_max_image_size){
+	atlas_builder->set_max_image_size(p_atlas_max_image_size);
+}
+
+int32_t TextureContentLoader::get_atlas_max_image_size() const{
+	return atlas_builder->get_max_image_size();
+}
+
+void TextureContentLoader::clear_texture_cache(){
+	texture_cache->clear();
+	atlas_builder->clear();
+}
+
+// Pick the Image compression mode for the configured setting and this GPU.
+Image::CompressMode TextureContentLoader::get_compress_mode() const{
+	switch (vram_compression){
+	case VRAM_COMPRESSION_BPTC:
+		return Image::COMPRESS_BPTC;
+	case VRAM_COMPRESSION_S3TC:
+		return Image::COMPRESS_S3TC;
+	case VRAM_COMPRESSION_ETC2:
+		return Image::COMPRESS_ETC2;
+	case VRAM_COMPRESSION_AUTO: {
+		RenderingServer *rendering_server = RenderingServer::get_singleton();
+		if (rendering_server->has_os_feature("bptc")){
+			return Image::COMPRESS_BPTC;
+		}else if (rendering_server->has_os_feature("s3tc")){
+			return Image::COMPRESS_S3TC;
+		}else if (rendering_server->has_os_feature("etc2")){
+			return Image::COMPRESS_ETC2;
+		}
+		return Image::COMPRESS_MAX;
+	}
+	default:
+		return Image::COMPRESS_MAX;
+	}
+}
+
+// Cache entry suffix describing the processing applied; empty when the image is used as decoded.
+// Uncompressed mip chains are cached too, so mipmaps are generated once per source file.
+String TextureContentLoader::get_cache_variant() const{
+	String compress_stage = "";
+	switch (get_compress_mode()){
+	case Image::COMPRESS_BPTC:
+		compress_stage = "bptc";
+		break;
+	case Image::COMPRESS_S3TC:
+		compress_stage = "s3tc";
+		break;
+	case Image::COMPRESS_ETC2:
+		compress_stage = "etc2";
+		break;
+	default:
+		return generate_mipmaps ? "mip" : "";
+	}
+
+	return generate_mipmaps ? "mip_" + compress_stage : compress_stage;
+}
+
+// Apply the configured processing to a freshly decoded image.
+// Mipmaps are generated before compression since compressed images cannot be resampled.
+Ref<Image> TextureContentLoader::process_image(const Ref<Image> &image) const{
+	Image::CompressMode compress_mode = get_compress_mode();
+	if (image->is_compressed() || (!generate_mipmaps && compress_mode == Image::COMPRESS_MAX)){
+		return image;
+	}
+
+	decode_limiter->acquire_slot();
+
+	if (generate_mipmaps && !image->has_mipmaps()){
+		if (image->generate_mipmaps() != OK){
+			EAM_LOG_WARNING("Failed to generate mipmaps for dynamic texture.");
+		}
+	}
+
+	if (compress_mode != Image::COMPRESS_MAX){
+		if (image->compress(compress_mode) != OK){
+			EAM_LOG_WARNING("VRAM compression unavailable, using uncompressed texture.");
+		}
+	}
+
+	decode_limiter->release_slot();
+
+	return image;
+}
+
+// Decode the image, streaming it in the background when it is large enough.
+Variant TextureContentLoader::decode_from_path(const String &p_path) const {
+	if (atlas_directories.has(p_path.get_base_dir().get_file())){
+		Ref<AtlasTexture> atlas_region = atlas_builder->get_region(p_path);
+		if (atlas_region.is_valid()){
+			return atlas_region;
+		}
+	}
+
+	if (streaming_enabled){
+		Variant placeholder = decode_stream_placeholder(p_path);
+		if (placeholder.get_type() == Variant::OBJECT){
+			return placeholder;
+		}
+	}
+
+	return decode_full_image(p_path);
+}
+
+// Read the image file and decode it, or reuse a processed copy from the texture cache.
+Variant TextureContentLoader::decode_full_image(const String &p_path) const {
+	String cache_variant = get_cache_variant();
+	if (cache_variant == ""){
+		auto loaded_image = decode_limiter->decode_image(p_path);
+		if (loaded_image.is_null()){
+			EAM_LOG_ERROR("Error loading image from file.");
+			return FAILED;
+		}
+
+		store_preview(p_path, loaded_image);
+		return process_image(loaded_image);
+	}
+
+	PackedByteArray buffer = FileAccess::get_file_as_bytes(p_path);
+	if (buffer.is_empty()){
+		EAM_LOG_ERROR("Error loading image from file.");
+		return FAILED;
+	}
+
+	String source_hash = DataCacheManager::hash_buffer(buffer, DataCacheManager::HASH_ALGORITHM_SHA256);
+	Ref<Image> cached_image = texture_cache->load_image(source_hash, cache_variant);
+	if (cached_image.is_valid()){
+		return cached_image;
+	}
+
+	auto loaded_image = decode_limiter->decode_image_buffer(buffer, p_path);
+	if (loaded_image.is_null()){
+		EAM_LOG_ERROR("Error loading image from file.");
+		return FAILED;
+	}
+
+	store_preview(p_path, loaded_image);
+
+	// Only cache images whose processing succeeded, so a failed compression is retried next time.
+	loaded_image = process_image(loaded_image);
+	bool processed = get_compress_mode() == Image::COMPRESS_MAX ? loaded_image->has_mipmaps() : loaded_image->is_compressed();
+	if (processed){
+		texture_cache->store_image(source_hash, cache_variant, loaded_image);
+	}
+
+	return loaded_image;
+}
+
+// Create the texture resource from the decoded image.
+Variant TextureContentLoader::finalize_resource(const Variant &p_decoded, const String &p_path) const {
+	Ref<AtlasTexture> atlas_region = p_decoded;
+	if (atlas_region.is_valid()){
+		return atlas_region;
+	}
+
+	Ref<Image> loaded_image = p_decoded;
+
+	auto loaded_texture = ImageTexture::create_from_image(loaded_image);
+	if (loaded_texture.is_null()){
+		EAM_LOG_ERROR("error loading dynamic texture: '" + p_path + "'");
+		return FAILED;
+	}
+
+	if (loaded_image->has_meta("stream_size")){
+		loaded_texture->set_size_override(loaded_image->get_meta("stream_size"));
+		start_stream(loaded_texture, p_path);
+	}
+
+	return loaded_texture;
+}
+
+// Video memory of the full resolution texture, assuming four bytes per pixel.
+// Atlas regions count their share of the page.
+int64_t TextureContentLoader::estimate_resource_size(const Variant &p_resource, const String &p_path) const {
+	Ref<AtlasTexture> atlas_region = p_resource;
+	if (atlas_region.is_valid()){
+		return (int64_t)atlas_region->get_width() * atlas_region->get_height() * 4;
+	}
+
+	Ref<ImageTexture> texture = p_resource;
+	if (texture.is_null()){
+		return 0;
+	}
+
+	int64_t size_bytes = (int64_t)texture->get_width() * texture->get_height() * 4;
+	if (generate_mipmaps){
+		size_bytes = size_bytes * 4 / 3;
+	}
+	return size_bytes;
+}
+
+// Cache key for the preview of a file, derived from its path, size and modification time.
+String TextureContentLoader::get_preview_key(const String &p_path) const{
+	int64_t file_size = _get_file_size(p_path);
+	if (file_size < 0){
+		return "";
+	}
+
+	String file_stamp = p_path + ":" + String::num_int64(file_size) + ":" + String::num_uint64(FileAccess::get_modified_time(p_path));
+	return DataCacheManager::compute_string_hash(file_stamp, DataCacheManager::HASH_ALGORITHM_SHA256);
+}
+
+// Keep a tiny copy of large images to show while they stream in on later loads.
+void TextureContentLoader::store_preview(const String &p_path, const Ref<Image> &image) const{
+	if (!streaming_enabled || image->is_compressed()){
+		return;
+	}
+
+	if (_get_file_size(p_path) < streaming_min_file_size){
+		return;
+	}
+
+	String preview_key = get_preview_key(p_path);
+	if (preview_key == ""){
+		return;
+	}
+
+	Ref<Image> preview = image->duplicate();
+	Vector2i size = preview->get_size();
+	float scale = (float)STREAM_PREVIEW_SIZE / (float)MAX(size.x, size.y);
+	if (scale < 1.0){
+		preview->resize(MAX(1, (int32_t)(size.x * scale)), MAX(1, (int32_t)(size.y * scale)), Image::INTERPOLATE_BILINEAR);
+	}
+
+	texture_cache->store_image(preview_key, "preview", preview);
+}
+
+// Build the placeholder image for a streamed texture; FAILED when the file should load synchronously.
+Variant TextureContentLoader::decode_stream_placeholder(const String &p_path) const{
+	if (_get_file_size(p_path) < streaming_min_file_size){
+		return FAILED;
+	}
+
+	Vector2i full_size = ImageDecodeLimiter::read_image_size(p_path);
+	if (full_size.x <= 0 || full_size.y <= 0){
+		return FAILED;
+	}
+
+	Ref<Image> placeholder = texture_cache->load_image(get_preview_key(p_path), "preview");
+	if (placeholder.is_null()){
+		placeholder = Image::create_empty(1, 1, false, Image::FORMAT_RGBA8);
+		placeholder->fill(Color(0, 0, 0, 0));
+	}
+
+	placeholder->set_meta("stream_size", full_size);
+	return placeholder;
+}
+
+// Queue the full resolution decode for a placeholder texture.
+void TextureContentLoader::start_stream(const Ref<ImageTexture> &texture, const String &p_path) const{
+	reap_stream_tasks(false);
+
+	auto self = const_cast<TextureContentLoader *>(this);
+	int64_t task_id = WorkerThreadPool::get_singleton()->add_task(
+		callable_mp(self, &TextureContentLoader::_stream_full_image).bind(texture, p_path),
+		false,
+		"Dynamic texture stream: " + p_path
+	);
+
+	MutexLock lock{**stream_mutex};
+	stream_task_ids.push_back(task_id);
+}
+
+// Wait for every queued full resolution stream.
+void TextureContentLoader::wait_for_background_tasks(){
+	reap_stream_tasks(true);
+}
+
+// Release finished stream tasks, or wait for all of them.
+void TextureContentLoader::reap_stream_tasks(bool wait_all) const{
+	LocalVector<int64_t> finished_ids;
+	{
+		MutexLock lock{**stream_mutex};
+		for (uint32_t i = 0; i < stream_task_ids.size();){
+			int64_t task_id = stream_task_ids[i];
+			if (wait_all || WorkerThreadPool::get_singleton()->is_task_completed(task_id)){
+				finished_ids.push_back(task_id);
+				stream_task_ids.remove_at_unordered(i);
+			}else{
+				i++;
+			}
+		}
+	}
+
+	for (int64_t task_id : finished_ids){
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	}
+}
+
+// Worker entry point: decode the full image and swap it into the texture on the main thread.
+void TextureContentLoader::_stream_full_image(Ref<ImageTexture> texture, String p_path){
+	Ref<Image> full_image = decode_full_image(p_path);
+	if (full_image.is_null()){
+		EAM_LOG_ERROR("Failed to stream dynamic texture: '" + p_path + "'");
+		return;
+	}
+
+	texture->call_deferred("set_image", full_image);
+	call_deferred("emit_signal", "texture_streamed", texture, p_path);
+}
@@ -1,4 +1,5 @@
 #include "xml_loader.hpp"
+#include "asset_logger.hpp"
 
 #include <filesystem>
 #include <godot_cpp/variant/utility_functions.hpp>
@@ -110,7 +111,7 @@ XmlDocument XmlLoader::load_xml_file(const std::string& file_path) {
     if (!std::filesystem::exists(file_path)) {
         doc.is_valid = false;
         doc.error_message = "File does not exist: " + file_path;
-        UtilityFunctions::push_error("XmlLoader: ", String(doc.error_message.c_str()));
+        EAM_LOG_ERROR("XmlLoader: ", String(doc.error_message.c_str()));
         return doc;
     }
     
@@ -121,7 +122,7 @@ XmlDocument XmlLoader::load_xml_file(const std::string& file_path) {
     if (!result) {
         doc.is_valid = false;
         doc.error_message = std::string("Failed to parse XML file: ") + result.description();
-        UtilityFunctions::push_error("XmlLoader: ", String(doc.error_message.c_str()));
+        EAM_LOG_ERROR("XmlLoader: ", String(doc.error_message.c_str()));
         return doc;
     }
     
@@ -129,7 +130,7 @@ XmlDocument XmlLoader::load_xml_file(const std::string& file_path) {
     doc.root = convert_pugi_node(pugi_doc.document_element());
     doc.is_valid = true;
     
-    UtilityFunctions::print("Successfully loaded XML file: ", String(file_path.c_str()));
+    EAM_LOG_DEBUG("Successfully loaded XML file: ", String(file_path.c_str()));
     return doc;
 }
 
@@ -142,7 +143,7 @@ XmlDocument XmlLoader::parse_xml_string(const std::string& xml_content) {
     if (!result) {
         doc.is_valid = false;
         doc.error_message = std::string("Failed to parse XML string: ") + result.description();
-        UtilityFunctions::push_error("XmlLoader: ", String(doc.error_message.c_str()));
+        EAM_LOG_ERROR("XmlLoader: ", String(doc.error_message.c_str()));
         return doc;
     }
     
@@ -158,7 +159,7 @@ std::vector<std::string> XmlLoader::list_files_from_directory(const std::string&
     
     // Verify path exists
     if (!std::filesystem::exists(path)) {
-        UtilityFunctions::push_error("XmlLoader::list_files_from_directory: Path does not exist: ", String(path.c_str()));
+        EAM_LOG_ERROR("XmlLoader::list_files_from_directory: Path does not exist: ", String(path.c_str()));
         return file_names;
     }
     
@@ -0,0 +1,145 @@
+#include "xxhash64.hpp"
+
+#include <cstring>
+
+using namespace godot;
+
+static constexpr uint64_t PRIME64_1 = 11400714785074694791ULL;
+static constexpr uint64_t PRIME64_2 = 14029467366897019727ULL;
+static constexpr uint64_t PRIME64_3 = 1609587929392839161ULL;
+static constexpr uint64_t PRIME64_4 = 9650029242287828579ULL;
+static constexpr uint64_t PRIME64_5 = 2870177450012600261ULL;
+
+static inline uint64_t rotl64(uint64_t value, int bits) {
+	return (value << bits) | (value >> (64 - bits));
+}
+
+// Little endian reads; memcpy keeps unaligned access well defined.
+static inline uint64_t read64(const uint8_t *data) {
+	uint64_t value;
+	memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	value = __builtin_bswap64(value);
+#endif
+	return value;
+}
+
+static inline uint32_t read32(const uint8_t *data) {
+	uint32_t value;
+	memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	value = __builtin_bswap32(value);
+#endif
+	return value;
+}
+
+static inline uint64_t round64(uint64_t accumulator, uint64_t input) {
+	accumulator += input * PRIME64_2;
+	accumulator = rotl64(accumulator, 31);
+	return accumulator * PRIME64_1;
+}
+
+static inline uint64_t merge_round64(uint64_t hash, uint64_t accumulator) {
+	hash ^= round64(0, accumulator);
+	return hash * PRIME64_1 + PRIME64_4;
+}
+
+XXHash64::XXHash64(uint64_t p_seed) {
+	reset(p_seed);
+}
+
+void XXHash64::reset(uint64_t p_seed) {
+	seed = p_seed;
+	accumulators[0] = seed + PRIME64_1 + PRIME64_2;
+	accumulators[1] = seed + PRIME64_2;
+	accumulators[2] = seed;
+	accumulators[3] = seed - PRIME64_1;
+	total_length = 0;
+	stripe_size = 0;
+}
+
+void XXHash64::consume_stripe(const uint8_t *data) {
+	accumulators[0] = round64(accumulators[0], read64(data));
+	accumulators[1] = round64(accumulators[1], read64(data + 8));
+	accumulators[2] = round64(accumulators[2], read64(data + 16));
+	accumulators[3] = round64(accumulators[3], read64(data + 24));
+}
+
+void XXHash64::update(const uint8_t *data, size_t length) {
+	total_length += length;
+
+	// Complete a stripe left over from the previous update first.
+	if (stripe_size > 0){
+		size_t missing = sizeof(stripe) - stripe_size;
+		if (length < missing){
+			memcpy(stripe + stripe_size, data, length);
+			stripe_size += length;
+			return;
+		}
+
+		memcpy(stripe + stripe_size, data, missing);
+		consume_stripe(stripe);
+		data += missing;
+		length -= missing;
+		stripe_size = 0;
+	}
+
+	while (length >= sizeof(stripe)){
+		consume_stripe(data);
+		data += sizeof(stripe);
+		length -= sizeof(stripe);
+	}
+
+	if (length > 0){
+		memcpy(stripe, data, length);
+		stripe_size = length;
+	}
+}
+
+uint64_t XXHash64::digest() const {
+	uint64_t hash;
+	if (total_length >= sizeof(stripe)){
+		hash = rotl64(accumulators[0], 1) + rotl64(accumulators[1], 7) + rotl64(accumulators[2], 12) + rotl64(accumulators[3], 18);
+		for (uint64_t accumulator : accumulators){
+			hash = merge_round64(hash, accumulator);
+		}
+	} else {
+		hash = seed + PRIME64_5;
+	}
+
+	hash += total_length;
+
+	const uint8_t *data = stripe;
+	const uint8_t *end = stripe + stripe_size;
+
+	while (data + 8 <= end){
+		hash ^= round64(0, read64(data));
+		hash = rotl64(hash, 27) * PRIME64_1 + PRIME64_4;
+		data += 8;
+	}
+
+	if (data + 4 <= end){
+		hash ^= uint64_t(read32(data)) * PRIME64_1;
+		hash = rotl64(hash, 23) * PRIME64_2 + PRIME64_3;
+		data += 4;
+	}
+
+	while (data < end){
+		hash ^= (*data) * PRIME64_5;
+		hash = rotl64(hash, 11) * PRIME64_1;
+		data++;
+	}
+
+	hash ^= hash >> 33;
+	hash *= PRIME64_2;
+	hash ^= hash >> 29;
+	hash *= PRIME64_3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+uint64_t XXHash64::hash(const uint8_t *data, size_t length, uint64_t p_seed) {
+	XXHash64 state{p_seed};
+	state.update(data, length);
+	return state.digest();
+}